@@ -15,6 +15,7 @@
 #include <AMReX_FabSet.H>
 #include <AMReX_StateData.H>
 #include <AMReX_PlotFileUtil.H>
+#include <AMReX_RecycleArena.H>
 #include <AMReX_Print.H>
 
 #ifdef BL_LAZY
@@ -2651,7 +2652,17 @@ Amr::regrid (int  lbase,
             new_dmap[lev] = makeLoadBalanceDistributionMap(lev, time, new_grid_places[lev]);
         }
         else if (new_dmap[lev].empty()) {
-            new_dmap[lev].define(new_grid_places[lev]);
+            if (incremental_regrid && !initial && amr_level[lev]) {
+                //
+                // Unchanged boxes stay where their data are.
+                //
+                new_dmap[lev] = DistributionMapping::makeIncremental
+                    (new_grid_places[lev], amr_level[lev]->boxArray(),
+                     amr_level[lev]->DistributionMap(), incremental_regrid_max_imbalance);
+            }
+            if (new_dmap[lev].empty()) {
+                new_dmap[lev].define(new_grid_places[lev]);
+            }
         }
 
         AmrLevel* a = (*levelbld)(*this,lev,Geom(lev),new_grid_places[lev],
@@ -2703,6 +2714,21 @@ Amr::regrid (int  lbase,
         amr_level[lev]->post_regrid(lbase,new_finest);
     }
 
+    //
+    // The StateData freed during this regrid are kept for the next one.
+    //
+    if (auto* ra = dynamic_cast<RecycleArena*>(The_Recycle_Arena())) {
+        auto [nhits, nmisses] = ra->hits_and_misses();
+        const std::size_t nreleased = ra->ReleaseStale();
+        if (verbose > 1) {
+            Long r[3] = {nhits, nmisses, static_cast<Long>(nreleased)};
+            ParallelDescriptor::ReduceLongSum(r, 3, ParallelDescriptor::IOProcessorNumber());
+            amrex::Print() << "Amr::regrid: " << r[0] << " of " << r[0]+r[1]
+                           << " StateData blocks reused, "
+                           << r[2]/(1024*1024) << " MB released to The_Arena\n";
+        }
+    }
+
     //
     // Report creation of new grids.
     //
@@ -18,6 +18,8 @@
 #include <sstream>
 #include <memory>
 #include <limits>
+#include <utility>
+#include <vector>
 
 namespace amrex {
 
@@ -2196,11 +2198,113 @@ AmrLevel::FillPatch (AmrLevel& amrlevel,
     BL_PROFILE("AmrLevel::FillPatch()");
     BL_ASSERT(dcomp+ncomp-1 <= leveldata.nComp());
     BL_ASSERT(leveldata.nGrowVect().allGE(boxGrow));
+
+    if (boxGrow == 0 && amrlevel.parent->useIncrementalRegrid() &&
+        FillPatchIncremental(amrlevel, leveldata, time, index, scomp, ncomp, dcomp))
+    {
+        return;
+    }
+
     FillPatchIterator fpi(amrlevel, leveldata, boxGrow, time, index, scomp, ncomp);
     const MultiFab& mf_fillpatched = fpi.get_mf();
     MultiFab::Copy(leveldata, mf_fillpatched, 0, dcomp, ncomp, boxGrow);
 }
 
+bool
+AmrLevel::FillPatchIncremental (AmrLevel& amrlevel,
+                                MultiFab& leveldata,
+                                Real      time,
+                                int       index,
+                                int       scomp,
+                                int       ncomp,
+                                int       dcomp)
+{
+    if (leveldata.hasEBFabFactory()) { return false; }
+
+    Vector<MultiFab*> smf;
+    Vector<Real> stime;
+    amrlevel.state[index].getData(smf,stime,time);
+    if (smf.size() != 1) { return false; }
+    const MultiFab& src = *smf[0];
+    //
+    // Find the boxes of leveldata that are also boxes of src on the same
+    // process.  Their valid data are copied locally.
+    //
+    const BoxArray& ba = leveldata.boxArray();
+    const DistributionMapping& dm = leveldata.DistributionMap();
+    const BoxArray& src_ba = src.boxArray();
+    const DistributionMapping& src_dm = src.DistributionMap();
+    if (ba.ixType() != src_ba.ixType()) { return false; }
+
+    const int N = static_cast<int>(ba.size());
+    Vector<int> src_index(N, -1);
+    Vector<int> changed;
+    std::vector<std::pair<int,Box>> isects;
+    for (int i = 0; i < N; ++i)
+    {
+        const Box& bx = ba[i];
+        src_ba.intersections(bx, isects);
+        for (auto const& is : isects) {
+            if (is.second == bx && src_ba[is.first] == bx && src_dm[is.first] == dm[i]) {
+                src_index[i] = is.first;
+                break;
+            }
+        }
+        if (src_index[i] < 0) { changed.push_back(i); }
+    }
+    if (static_cast<int>(changed.size()) == N) { return false; }
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(leveldata,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const int isrc = src_index[mfi.index()];
+        if (isrc < 0) { continue; }
+        const Box& bx = mfi.tilebox();
+        auto const& d = leveldata.array(mfi);
+        auto const& s = src.const_array(isrc);
+        ParallelFor(bx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        {
+            d(i,j,k,n+dcomp) = s(i,j,k,n+scomp);
+        });
+    }
+    //
+    // Only the other boxes are filled with FillPatchIterator.
+    //
+    if (!changed.empty())
+    {
+        BoxList bl(ba.ixType());
+        Vector<int> pmap;
+        bl.reserve(changed.size());
+        pmap.reserve(changed.size());
+        for (int i : changed) {
+            bl.push_back(ba[i]);
+            pmap.push_back(dm[i]);
+        }
+        MultiFab mf_changed(BoxArray(std::move(bl)), DistributionMapping(std::move(pmap)),
+                            ncomp, 0, MFInfo().SetAlloc(false));
+        FillPatchIterator fpi(amrlevel, mf_changed, 0, time, index, scomp, ncomp);
+        const MultiFab& mf_fillpatched = fpi.get_mf();
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(mf_fillpatched,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            auto const& d = leveldata.array(changed[mfi.index()]);
+            auto const& s = mf_fillpatched.const_array(mfi);
+            ParallelFor(bx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+            {
+                d(i,j,k,n+dcomp) = s(i,j,k,n);
+            });
+        }
+    }
+
+    return true;
+}
+
 void
 AmrLevel::FillPatchAdd (AmrLevel& amrlevel,
                         MultiFab& leveldata,
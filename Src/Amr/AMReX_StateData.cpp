@@ -100,7 +100,7 @@ StateData::define (const Box&             p_domain,
     BL_PROFILE("StateData::define()");
     domain = p_domain;
     desc = &d;
-    arena = nullptr;
+    arena = The_Recycle_Arena();
     grids = grds;
     dmap = dm;
     m_factory.reset(factory.clone());
@@ -184,7 +184,7 @@ StateData::restart (std::istream&          is,
                     const std::string&     chkfile)
 {
     desc = &d;
-    arena = nullptr;
+    arena = The_Recycle_Arena();
     domain = p_domain;
     grids = grds;
     dmap = dm;
@@ -285,7 +285,7 @@ StateData::restart (const StateDescriptor& d,
                     const StateData& rhs)
 {
     desc = &d;
-    arena = nullptr;
+    arena = The_Recycle_Arena();
     domain = rhs.domain;
     grids = rhs.grids;
     old_time.start = rhs.old_time.start;
@@ -1,5 +1,6 @@
 
 #include <AMReX_AmrCore.H>
+#include <AMReX_RecycleArena.H>
 
 #ifdef AMREX_PARTICLES
 #include <AMReX_AmrParGDB.H>
@@ -103,7 +104,15 @@ AmrCore::regrid (int lbase, Real time, bool)
                 DistributionMapping level_dmap = dmap[lev];
                 if (ba_changed) {
                     level_grids = new_grids[lev];
-                    level_dmap = MakeDistributionMap(lev, level_grids);
+                    // The new boxes are given to the processes with the
+                    // least work, unless the load is too imbalanced.
+                    level_dmap = incremental_regrid
+                        ? DistributionMapping::makeIncremental(level_grids, grids[lev], dmap[lev],
+                                                               incremental_regrid_max_imbalance)
+                        : DistributionMapping{};
+                    if (level_dmap.empty()) {
+                        level_dmap = MakeDistributionMap(lev, level_grids);
+                    }
                 }
                 const auto old_num_setdm = num_setdm;
                 RemakeLevel(lev, time, level_grids, level_dmap);
@@ -133,6 +142,11 @@ AmrCore::regrid (int lbase, Real time, bool)
     }
 
     finest_level = new_finest;
+
+    // Blocks freed during this regrid are kept for the next one.
+    if (auto* ra = dynamic_cast<RecycleArena*>(The_Recycle_Arena())) {
+        ra->ReleaseStale();
+    }
 }
 
 
@@ -375,6 +375,9 @@ AmrMesh::InitAmrMesh (int max_level_in, const Vector<int>& n_cell_in,
     }
 
     pp.queryAdd("check_input", check_input);
+    pp.queryAdd("distributed_cluster", distributed_cluster);
+    pp.queryAdd("incremental_regrid", incremental_regrid);
+    pp.queryAdd("incremental_regrid_max_imbalance", incremental_regrid_max_imbalance);
 
     finest_level = -1;
 
@@ -733,10 +736,19 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
         // Create initial cluster containing all tagged points.
         //
         Gpu::PinnedVector<IntVect> tagvec;
-        tags.collate(tagvec);
+        bool has_tags;
+        if (distributed_cluster) {
+            tags.local_collate(tagvec);
+            Long ntags = static_cast<Long>(tagvec.size());
+            ParallelDescriptor::ReduceLongSum(ntags);
+            has_tags = ntags > 0;
+        } else {
+            tags.collate(tagvec);
+            has_tags = !tagvec.empty();
+        }
         tags.clear();
 
-        if (!tagvec.empty())
+        if (has_tags)
         {
             //
             // Created new level, now generate efficient grids.
@@ -747,23 +759,33 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
 
             if (levf > useFixedUpToLevel()) {
                 BoxList new_bx;
-                if (ParallelDescriptor::IOProcessor()) {
+                if (distributed_cluster || ParallelDescriptor::IOProcessor()) {
                     BL_PROFILE("AmrMesh-cluster");
-                    //
-                    // Construct initial cluster.
-                    //
-                    ClusterList clist(tagvec.data(), static_cast<Long>(tagvec.size()));
-                    if (use_new_chop) {
-                        clist.new_chop(grid_eff);
+                    if (distributed_cluster) {
+                        //
+                        // Every process clusters its own tags and gets the same boxes.
+                        //
+                        new_bx = ClusterList::distributedBoxList(tagvec.data(),
+                                                                 static_cast<Long>(tagvec.size()),
+                                                                 grid_eff, use_new_chop,
+                                                                 p_n_ba[levc]);
                     } else {
-                        clist.chop(grid_eff);
+                        //
+                        // Construct initial cluster.
+                        //
+                        ClusterList clist(tagvec.data(), static_cast<Long>(tagvec.size()));
+                        if (use_new_chop) {
+                            clist.new_chop(grid_eff);
+                        } else {
+                            clist.chop(grid_eff);
+                        }
+                        clist.intersect(p_n_ba[levc]);
+                        //
+                        // Efficient properly nested Clusters have been constructed
+                        // now generate list of grids at level levf.
+                        //
+                        clist.boxList(new_bx);
                     }
-                    clist.intersect(p_n_ba[levc]);
-                    //
-                    // Efficient properly nested Clusters have been constructed
-                    // now generate list of grids at level levf.
-                    //
-                    clist.boxList(new_bx);
                     new_bx.refine(bf_lev[levc]);
                     new_bx.simplify();
 
@@ -772,7 +794,9 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
                         new_bx.intersect(Geom(levc).Domain());
                     }
                 }
-                new_bx.Bcast();  // Broadcast the new BoxList to other processes
+                if (!distributed_cluster) {
+                    new_bx.Bcast();  // Broadcast the new BoxList to other processes
+                }
 
                 bool odd_ref_ratio = false;
                 for (auto const& rr : ref_ratio[levc]) {
@@ -1257,6 +1281,9 @@ std::ostream& operator<< (std::ostream& os, AmrMesh const& amr_mesh)
     os << "  check_input = " << amr_mesh.check_input  << "\n";
     os << "  use_new_chop = " << amr_mesh.use_new_chop << "\n";
     os << "  iterate_on_new_grids = " << amr_mesh.iterate_on_new_grids << "\n";
+    os << "  distributed_cluster = " << amr_mesh.distributed_cluster << "\n";
+    os << "  incremental_regrid = " << amr_mesh.incremental_regrid << "\n";
+    os << "  incremental_regrid_max_imbalance = " << amr_mesh.incremental_regrid_max_imbalance << "\n";
     return os;
 }
 
@@ -5,9 +5,12 @@
 #include <AMReX_Vector.H>
 #include <AMReX_Array.H>
 #include <AMReX_BLProfiler.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParallelReduce.H>
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace amrex {
 
@@ -576,4 +579,342 @@ ClusterList::intersect (BoxArray& domba)
     domba.clear();
 }
 
+namespace {
+
+//
+// A cluster of ClusterList::distributedBoxList.  The box and the number of tags are
+// global.  The points of this process are [begin,end) of its array.
+//
+struct DistNode
+{
+    Box  box;
+    Long ntag = 0;
+    Long begin = 0;
+    Long end = 0;
+    int  lo_child = -1;
+    int  hi_child = -1;
+};
+
+struct DistCut
+{
+    int dir = 0;
+    int cut = 0;
+};
+
+Real
+DistEff (Long ntag, const Box& bx) noexcept
+{
+    return static_cast<Real>(double(ntag) / bx.d_numPts());
+}
+
+//
+// The cut Cluster::chop chooses from the histograms if invalid_dir is
+// -1, or the second try of Cluster::new_chop.
+//
+DistCut
+DistSelectCut (const Box& bx,
+               const Array<Vector<int>,AMREX_SPACEDIM>& hist,
+               int invalid_dir)
+{
+    const int* lo = bx.loVect();
+    const int* hi = bx.hiVect();
+
+    CutStatus mincut = InvalidCut;
+    CutStatus status[AMREX_SPACEDIM] = {AMREX_D_DECL(InvalidCut,InvalidCut,InvalidCut)};
+    IntVect cut;
+    for (int n = 0; n < AMREX_SPACEDIM; n++)
+    {
+        if (n != invalid_dir)
+        {
+            cut[n] = FindCut(hist[n].data(), lo[n], hi[n], status[n]);
+            if (status[n] < mincut)
+            {
+                mincut = status[n];
+            }
+        }
+    }
+
+    DistCut r;
+    for (int n = 0, minlen = -1; n < AMREX_SPACEDIM; n++)
+    {
+        if (status[n] == mincut)
+        {
+            int mincutlen = std::min(cut[n]-lo[n],hi[n]-cut[n]);
+            if (mincutlen >= minlen)
+            {
+                r.dir = n;
+                r.cut = cut[n];
+                minlen = mincutlen;
+            }
+        }
+    }
+    return r;
+}
+
+//
+// Number of tags below the cut.
+//
+Long
+DistNumLo (const Box& bx, const Array<Vector<int>,AMREX_SPACEDIM>& hist, DistCut const& c)
+{
+    const int lo = bx.smallEnd(c.dir);
+    const int hi = std::min(c.cut, bx.bigEnd(c.dir)+1);
+    Long nlo = 0;
+    for (int i = lo; i < hi; i++) {
+        nlo += hist[c.dir][i-lo];
+    }
+    return nlo;
+}
+
+//
+// Bounding boxes of the points in boxes, reduced over all processes.
+// Each box is stored as the low end followed by the negative high end,
+// so that a single min reduction works.
+//
+constexpr int DistBoxSize = 2*AMREX_SPACEDIM;
+
+void
+DistInitBox (int* p) noexcept
+{
+    for (int d = 0; d < DistBoxSize; ++d) {
+        p[d] = std::numeric_limits<int>::max();
+    }
+}
+
+void
+DistAddPoint (int* p, const IntVect& iv) noexcept
+{
+    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+        p[d] = std::min(p[d], iv[d]);
+        p[d+AMREX_SPACEDIM] = std::min(p[d+AMREX_SPACEDIM], -iv[d]);
+    }
+}
+
+Box
+DistGetBox (const int* p) noexcept
+{
+    IntVect lo, hi;
+    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+        lo[d] = p[d];
+        hi[d] = -p[d+AMREX_SPACEDIM];
+    }
+    return Box(lo,hi);
+}
+
+}
+
+BoxList
+ClusterList::distributedBoxList (IntVect* pts, Long len, Real eff, bool use_new_chop,
+                                 const BoxArray& domba)
+{
+    BL_PROFILE("ClusterList::distributedBoxList()");
+
+    const MPI_Comm comm = ParallelDescriptor::Communicator();
+
+    Vector<DistNode> nodes(1);
+    {
+        Long ntag = len;
+        ParallelAllReduce::Sum(ntag, comm);
+        Vector<int> b(DistBoxSize);
+        DistInitBox(b.data());
+        for (Long i = 0; i < len; ++i) {
+            DistAddPoint(b.data(), pts[i]);
+        }
+        ParallelAllReduce::Min(b.data(), DistBoxSize, comm);
+        if (ntag == 0) { return BoxList(); }
+        nodes[0].box = DistGetBox(b.data());
+        nodes[0].ntag = ntag;
+        nodes[0].end = len;
+    }
+    //
+    // Chop the clusters with poor efficiency.  All the clusters that
+    // need a cut are cut together, with two reductions per round.
+    //
+    Vector<int> active;
+    if (DistEff(nodes[0].ntag, nodes[0].box) < eff) { active.push_back(0); }
+
+    while (!active.empty())
+    {
+        const auto nactive = static_cast<int>(active.size());
+        //
+        // Compute the histograms.
+        //
+        Vector<Long> hoff(nactive+1, 0);
+        for (int a = 0; a < nactive; ++a) {
+            const IntVect blen = nodes[active[a]].box.size();
+            hoff[a+1] = hoff[a] + AMREX_D_TERM(blen[0], + blen[1], + blen[2]);
+        }
+        Vector<Long> hbuf(hoff[nactive], 0);
+        for (int a = 0; a < nactive; ++a) {
+            DistNode const& nd = nodes[active[a]];
+            const IntVect blen = nd.box.size();
+            const IntVect& lo = nd.box.smallEnd();
+            Long* h = hbuf.data() + hoff[a];
+            for (Long i = nd.begin; i < nd.end; ++i) {
+                Long off = 0;
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                    h[off + pts[i][d]-lo[d]]++;
+                    off += blen[d];
+                }
+            }
+        }
+        ParallelAllReduce::Sum(hbuf.data(), static_cast<int>(hbuf.size()), comm);
+
+        Vector<Array<Vector<int>,AMREX_SPACEDIM>> hist(nactive);
+        Vector<Array<DistCut,2>> cuts(nactive);
+        for (int a = 0; a < nactive; ++a) {
+            DistNode const& nd = nodes[active[a]];
+            const IntVect blen = nd.box.size();
+            Long off = hoff[a];
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                hist[a][d].resize(blen[d]);
+                for (int i = 0; i < blen[d]; ++i) {
+                    hist[a][d][i] = static_cast<int>(hbuf[off+i]);
+                }
+                off += blen[d];
+            }
+            cuts[a][0] = DistSelectCut(nd.box, hist[a], -1);
+            cuts[a][1] = use_new_chop ? DistSelectCut(nd.box, hist[a], cuts[a][0].dir)
+                                      : cuts[a][0];
+        }
+        //
+        // Compute the bounding boxes of both sides of the candidate cuts.
+        //
+        const int ncand = use_new_chop ? 2 : 1;
+        Vector<int> bbuf(nactive*4*DistBoxSize);
+        for (int a = 0; a < nactive; ++a) {
+            DistNode const& nd = nodes[active[a]];
+            int* b = bbuf.data() + a*4*DistBoxSize;
+            for (int m = 0; m < 4; ++m) {
+                DistInitBox(b + m*DistBoxSize);
+            }
+            for (Long i = nd.begin; i < nd.end; ++i) {
+                for (int t = 0; t < ncand; ++t) {
+                    const int side = (pts[i][cuts[a][t].dir] < cuts[a][t].cut) ? 0 : 1;
+                    DistAddPoint(b + (2*t+side)*DistBoxSize, pts[i]);
+                }
+            }
+        }
+        ParallelAllReduce::Min(bbuf.data(), static_cast<int>(bbuf.size()), comm);
+        //
+        // Choose the cuts like chop or new_chop, and split the clusters.
+        //
+        Vector<int> next;
+        for (int a = 0; a < nactive; ++a) {
+            const int ia = active[a];
+            const int* b = bbuf.data() + a*4*DistBoxSize;
+            const Box  bx = nodes[ia].box;
+            const Long ntag = nodes[ia].ntag;
+
+            int t = 0;
+            Long nlo = DistNumLo(bx, hist[a], cuts[a][0]);
+            if (use_new_chop) {
+                const Real oldeff = DistEff(ntag, bx);
+                const Box blo = DistGetBox(b);
+                const Box bhi = DistGetBox(b + DistBoxSize);
+                if (nlo > 0 && nlo < ntag &&
+                    !(DistEff(nlo, blo) > oldeff) && !(DistEff(ntag-nlo, bhi) > oldeff))
+                {
+                    const Long nlo1 = DistNumLo(bx, hist[a], cuts[a][1]);
+                    if (nlo1 > 0 && nlo1 < ntag) {
+                        t = 1;
+                        nlo = nlo1;
+                    }
+                }
+            }
+            BL_ASSERT(nlo > 0 && nlo < ntag);
+
+            DistCut const& c = cuts[a][t];
+            IntVect* prt_it = std::partition(pts+nodes[ia].begin, pts+nodes[ia].end,
+                                             Cut(IntVect(c.cut), c.dir));
+
+            DistNode lo_node, hi_node;
+            lo_node.box   = DistGetBox(b + (2*t)*DistBoxSize);
+            lo_node.ntag  = nlo;
+            lo_node.begin = nodes[ia].begin;
+            lo_node.end   = prt_it - pts;
+            hi_node.box   = DistGetBox(b + (2*t+1)*DistBoxSize);
+            hi_node.ntag  = ntag - nlo;
+            hi_node.begin = lo_node.end;
+            hi_node.end   = nodes[ia].end;
+
+            const auto ilo = static_cast<int>(nodes.size());
+            nodes[ia].lo_child = ilo;
+            nodes[ia].hi_child = ilo+1;
+            nodes.push_back(lo_node);
+            nodes.push_back(hi_node);
+            for (int i : {ilo, ilo+1}) {
+                if (DistEff(nodes[i].ntag, nodes[i].box) < eff) { next.push_back(i); }
+            }
+        }
+        active = std::move(next);
+    }
+    //
+    // The order of the clusters in ClusterList::chop, which replaces a
+    // chopped cluster with its lower part and appends the upper part.
+    //
+    Vector<int> order{0};
+    for (int p = 0; p < static_cast<int>(order.size()); )
+    {
+        DistNode const& nd = nodes[order[p]];
+        if (nd.lo_child >= 0) {
+            order.push_back(nd.hi_child);
+            order[p] = nd.lo_child;
+        } else {
+            ++p;
+        }
+    }
+    //
+    // Intersect the clusters with domba like ClusterList::intersect.
+    //
+    BoxArray dom_ba(domba);
+    dom_ba.removeOverlap();
+    BoxDomain dom(dom_ba.boxList());
+
+    BoxList bl;
+    Vector<Box> pieces;
+    Vector<Long> pcount;
+    Vector<int> pbox;
+    for (int i : order)
+    {
+        DistNode const& nd = nodes[i];
+        bool assume_disjoint_ba = true;
+        if (dom_ba.contains(nd.box,assume_disjoint_ba))
+        {
+            bl.push_back(nd.box);
+        }
+        else
+        {
+            BoxDomain bxdom;
+            amrex::intersect(bxdom, dom, nd.box);
+            IntVect* it = pts + nd.begin;
+            for (auto const& b : bxdom)
+            {
+                IntVect* prt_it = std::partition(it, pts+nd.end, InBox(b));
+                pieces.push_back(b);
+                pcount.push_back(prt_it - it);
+                pbox.resize(pbox.size()+DistBoxSize);
+                int* p = pbox.data() + pbox.size() - DistBoxSize;
+                DistInitBox(p);
+                for (; it != prt_it; ++it) {
+                    DistAddPoint(p, *it);
+                }
+            }
+        }
+    }
+
+    if (!pieces.empty())
+    {
+        ParallelAllReduce::Sum(pcount.data(), static_cast<int>(pcount.size()), comm);
+        ParallelAllReduce::Min(pbox.data(), static_cast<int>(pbox.size()), comm);
+        for (int n = 0; n < static_cast<int>(pieces.size()); ++n) {
+            if (pcount[n] > 0) {
+                bl.push_back(DistGetBox(pbox.data() + n*DistBoxSize));
+            }
+        }
+    }
+
+    return bl;
+}
+
 }
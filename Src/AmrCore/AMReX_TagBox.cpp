@@ -589,11 +589,8 @@ TagBoxArray::local_collate_gpu (Gpu::PinnedVector<IntVect>& v) const
 #endif
 
 void
-TagBoxArray::collate (Gpu::PinnedVector<IntVect>& TheGlobalCollateSpace) const
+TagBoxArray::local_collate (Gpu::PinnedVector<IntVect>& TheLocalCollateSpace) const
 {
-    BL_PROFILE("TagBoxArray::collate()");
-
-    Gpu::PinnedVector<IntVect> TheLocalCollateSpace;
 #ifdef AMREX_USE_GPU
     if (Gpu::inLaunchRegion()) {
         local_collate_gpu(TheLocalCollateSpace);
@@ -602,6 +599,15 @@ TagBoxArray::collate (Gpu::PinnedVector<IntVect>& TheGlobalCollateSpace) const
     {
         local_collate_cpu(TheLocalCollateSpace);
     }
+}
+
+void
+TagBoxArray::collate (Gpu::PinnedVector<IntVect>& TheGlobalCollateSpace) const
+{
+    BL_PROFILE("TagBoxArray::collate()");
+
+    Gpu::PinnedVector<IntVect> TheLocalCollateSpace;
+    local_collate(TheLocalCollateSpace);
 
     Long count = static_cast<Long>(TheLocalCollateSpace.size());
 
@@ -45,6 +45,7 @@
 #include <AMReX_iMultiFab.H>
 #include <AMReX_VisMF.H>
 #include <AMReX_AsyncOut.H>
+#include <AMReX_CTOProfile.H>
 #endif
 
 #ifdef BL_LAZY
@@ -57,6 +58,7 @@
 
 #ifdef AMREX_USE_OMP
 #include <AMReX_OpenMP.H>
+#include <AMReX_ThreadPool.H>
 #include <omp.h>
 #endif
 
@@ -478,6 +480,7 @@ amrex::Initialize (int& argc, char**& argv, bool build_parm_parse,
 
 #ifdef AMREX_USE_OMP
     amrex::OpenMP::Initialize();
+    amrex::ThreadPool::Initialize();
 
     // status output
     if (system::verbose > 0) {
@@ -658,6 +661,7 @@ amrex::Initialize (int& argc, char**& argv, bool build_parm_parse,
     VisMF::Initialize();
     AsyncOut::Initialize();
     VectorGrowthStrategy::Initialize();
+    CTOProfile::Initialize();
 
 #ifdef AMREX_USE_FFT
     FFT::Initialize();
@@ -844,6 +848,7 @@ amrex::Finalize (amrex::AMReX* pamrex)
 #endif
 
 #ifdef AMREX_USE_OMP
+    amrex::ThreadPool::Finalize();
     amrex::OpenMP::Finalize();
 #endif
 
@@ -1,8 +1,11 @@
 
 #include <AMReX_Arena.H>
 #include <AMReX_BArena.H>
+#include <AMReX_BumpArena.H>
 #include <AMReX_CArena.H>
+#include <AMReX_NumaArena.H>
 #include <AMReX_PArena.H>
+#include <AMReX_RecycleArena.H>
 
 #include <AMReX.H>
 #include <AMReX_BLProfiler.H>
@@ -11,6 +14,12 @@
 #include <AMReX_ParmParse.H>
 #include <AMReX_Gpu.H>
 
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
 #ifdef _WIN32
 ///#include <memoryapi.h>
 //#define AMREX_MLOCK(x,y) VirtualLock(x,y)
@@ -18,7 +27,9 @@
 //#define AMREX_MLOCK(x,y) ((void)0)
 #define AMREX_MUNLOCK(x,y) ((void)0)
 #else
+#include <fcntl.h>
 #include <sys/mman.h>
+#include <unistd.h>
 //#define AMREX_MLOCK(x,y) mlock(x,y)
 #define AMREX_MUNLOCK(x,y) munlock(x,y)
 #endif
@@ -26,15 +37,64 @@
 namespace amrex {
 
 namespace {
+#if defined(__linux__)
+    constexpr std::size_t thp_size = 2*1024*1024;
+
+    //! Map at least nbytes with explicit huge pages.  Return nullptr on failure.
+    void* mmap_hugetlb (std::size_t& nbytes, Long page_size)
+    {
+#if defined(MAP_HUGETLB) && defined(MAP_HUGE_SHIFT)
+        const auto ps = static_cast<std::size_t>(page_size);
+        const std::size_t n = (nbytes + ps - 1) / ps * ps;
+        int log2ps = 0;
+        while ((std::size_t(1) << log2ps) < ps) { ++log2ps; }
+        void* p = mmap(nullptr, n, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (log2ps << MAP_HUGE_SHIFT), -1, 0);
+        if (p == MAP_FAILED) { return nullptr; }
+        nbytes = n;
+        return p;
+#else
+        amrex::ignore_unused(nbytes, page_size);
+        return nullptr;
+#endif
+    }
+
+    //! Map at least nbytes aligned to 2 MiB, and ask for transparent huge pages.
+    void* mmap_thp (std::size_t& nbytes)
+    {
+        const std::size_t n = (nbytes + thp_size - 1) / thp_size * thp_size;
+        void* p = mmap(nullptr, n + thp_size, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) { return nullptr; }
+        const auto addr = reinterpret_cast<std::uintptr_t>(p);
+        const auto aligned = (addr + thp_size - 1) / thp_size * thp_size;
+        if (aligned > addr) {
+            munmap(p, aligned - addr);
+        }
+        const std::size_t tail = (addr + n + thp_size) - (aligned + n);
+        if (tail > 0) {
+            munmap(reinterpret_cast<void*>(aligned + n), tail);
+        }
+#ifdef MADV_HUGEPAGE
+        madvise(reinterpret_cast<void*>(aligned), n, MADV_HUGEPAGE);
+#endif
+        nbytes = n;
+        return reinterpret_cast<void*>(aligned);
+    }
+#endif
+
     bool initialized = false;
 
     Arena* the_arena = nullptr;
     Arena* the_async_arena = nullptr;
+    Arena* the_bump_arena = nullptr;
+    Arena* the_recycle_arena = nullptr;
     Arena* the_device_arena = nullptr;
     Arena* the_managed_arena = nullptr;
     Arena* the_pinned_arena = nullptr;
     Arena* the_cpu_arena = nullptr;
     Arena* the_comms_arena = nullptr;
+    Arena* the_spill_arena = nullptr;
 
     Long the_arena_init_size = 0L;
     Long the_device_arena_init_size = 1024*1024*8;
@@ -47,7 +107,19 @@ namespace {
     Long the_pinned_arena_release_threshold = std::numeric_limits<Long>::max();
     Long the_comms_arena_release_threshold = std::numeric_limits<Long>::max();
     Long the_async_arena_release_threshold = std::numeric_limits<Long>::max();
+    Long the_arena_thread_cache_size = 0;
+    Long the_arena_thread_cache_max_block = 32768;
     bool the_arena_is_managed = false;
+    bool the_arena_numa = false;
+    bool the_arena_numa_interleave = true;
+    bool the_arena_use_hugepages = false;
+    Long the_arena_hugepage_size = 0;
+    bool the_arena_diagnostics = false;
+    bool use_bump_arena = false;
+    Long the_bump_arena_chunk_size = BumpArena::DefaultChunkSize;
+    bool use_recycle_arena = false;
+    std::string the_spill_arena_dir;
+    std::string the_spill_arena_advice("normal");
     bool abort_on_out_of_gpu_memory = false;
 }
 
@@ -152,7 +224,9 @@ Arena::allocate_system (std::size_t nbytes) // NOLINT(readability-make-member-fu
 #ifdef AMREX_USE_GPU
     if (arena_info.use_cpu_memory)
     {
-        p = std::malloc(nbytes);
+        p = allocate_spill(nbytes);
+        if (p == nullptr) { p = allocate_hugepages(nbytes); }
+        if (p == nullptr) { p = std::malloc(nbytes); }
 #ifndef _WIN32
 #if defined(__GNUC__) && !defined(__clang__)
 #pragma GCC diagnostic push
@@ -163,6 +237,9 @@ Arena::allocate_system (std::size_t nbytes) // NOLINT(readability-make-member-fu
 #pragma GCC diagnostic pop
 #endif
 #endif
+        if (p && (nbytes > 0) && arena_info.numa_node != -1) {
+            NumaArena::Bind(p, nbytes, arena_info.numa_node);
+        }
     }
     else if (arena_info.device_use_hostalloc)
     {
@@ -212,7 +289,9 @@ Arena::allocate_system (std::size_t nbytes) // NOLINT(readability-make-member-fu
         }
     }
 #else
-    p = std::malloc(nbytes);
+    p = allocate_spill(nbytes);
+    if (p == nullptr) { p = allocate_hugepages(nbytes); }
+    if (p == nullptr) { p = std::malloc(nbytes); }
 #ifndef _WIN32
 #if defined(__GNUC__) && !defined(__clang__)
 #pragma GCC diagnostic push
@@ -223,6 +302,9 @@ Arena::allocate_system (std::size_t nbytes) // NOLINT(readability-make-member-fu
 #pragma GCC diagnostic pop
 #endif
 #endif
+    if (p && (nbytes > 0) && arena_info.numa_node != -1) {
+        NumaArena::Bind(p, nbytes, arena_info.numa_node);
+    }
 #endif
     if (p == nullptr) { amrex::Abort("Sorry, malloc failed"); }
     return p;
@@ -234,6 +316,8 @@ Arena::deallocate_system (void* p, std::size_t nbytes) // NOLINT(readability-mak
 #ifdef AMREX_USE_GPU
     if (arena_info.use_cpu_memory)
     {
+        if (deallocate_spill(p)) { return; }
+        if (deallocate_hugepages(p)) { return; }
         if (p && arena_info.device_use_hostalloc) { AMREX_MUNLOCK(p, nbytes); }
         std::free(p);
     }
@@ -252,11 +336,175 @@ Arena::deallocate_system (void* p, std::size_t nbytes) // NOLINT(readability-mak
              sycl::free(p,Gpu::Device::syclContext()));
     }
 #else
+    if (deallocate_spill(p)) { return; }
+    if (deallocate_hugepages(p)) { return; }
     if (p && arena_info.device_use_hostalloc) { AMREX_MUNLOCK(p, nbytes); }
     std::free(p);
 #endif
 }
 
+void*
+Arena::allocate_hugepages (std::size_t nbytes)
+{
+    void* p = nullptr;
+#if defined(__linux__)
+    if (arena_info.use_hugepages && !arena_info.device_use_hostalloc)
+    {
+        std::size_t mapped = nbytes;
+        bool hugetlb = false;
+        if (arena_info.hugepage_size > 0 && nbytes >= static_cast<std::size_t>(arena_info.hugepage_size)) {
+            p = mmap_hugetlb(mapped, arena_info.hugepage_size);
+            hugetlb = (p != nullptr);
+            if (p == nullptr) {
+                static bool warned = false;
+                if (!warned) {
+                    warned = true;
+                    amrex::Warning("Arena: failed to allocate explicit huge pages of size "
+                                   + std::to_string(arena_info.hugepage_size)
+                                   + ", falling back to transparent huge pages");
+                }
+            }
+        }
+        if (p == nullptr && nbytes >= thp_size) {
+            p = mmap_thp(mapped);
+        }
+        if (p != nullptr) {
+            m_hugepage_allocs.emplace(p, HugePageAlloc{mapped, hugetlb});
+        }
+    }
+#else
+    amrex::ignore_unused(nbytes);
+#endif
+    return p;
+}
+
+bool
+Arena::deallocate_hugepages (void* p)
+{
+#if defined(__linux__)
+    auto it = m_hugepage_allocs.find(p);
+    if (it != m_hugepage_allocs.end()) {
+        munmap(p, it->second.nbytes);
+        m_hugepage_allocs.erase(it);
+        return true;
+    }
+#else
+    amrex::ignore_unused(p);
+#endif
+    return false;
+}
+
+void*
+Arena::allocate_spill (std::size_t nbytes)
+{
+    if (arena_info.spill_directory.empty() || nbytes == 0) { return nullptr; }
+#ifndef _WIN32
+    std::string name = arena_info.spill_directory + "/amrex_spill_XXXXXX";
+    const int fd = mkstemp(name.data());
+    if (fd < 0) {
+        amrex::Abort("Arena: failed to create a file in " + arena_info.spill_directory);
+    }
+    // The file is removed when it is unmapped.
+    unlink(name.c_str());
+
+    // Reserve the blocks now.  Otherwise running out of disk space would
+    // show up as SIGBUS when the memory is touched.
+#if defined(__linux__)
+    const int r = posix_fallocate(fd, 0, static_cast<off_t>(nbytes));
+#else
+    const int r = ftruncate(fd, static_cast<off_t>(nbytes));
+#endif
+    if (r != 0) {
+        close(fd);
+        amrex::Abort("Arena: failed to reserve " + std::to_string(nbytes)
+                     + " bytes in " + arena_info.spill_directory);
+    }
+
+    void* p = mmap(nullptr, nbytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        amrex::Abort("Arena: failed to map " + std::to_string(nbytes)
+                     + " bytes in " + arena_info.spill_directory);
+    }
+
+    if (arena_info.spill_advice == ArenaInfo::SpillAdvice::Sequential) {
+        madvise(p, nbytes, MADV_SEQUENTIAL);
+    } else if (arena_info.spill_advice == ArenaInfo::SpillAdvice::Random) {
+        madvise(p, nbytes, MADV_RANDOM);
+    }
+
+    m_spill_allocs.emplace(p, nbytes);
+    return p;
+#else
+    amrex::Abort("Arena: file backed memory is not supported on this platform");
+    return nullptr;
+#endif
+}
+
+bool
+Arena::deallocate_spill (void* p)
+{
+#ifndef _WIN32
+    auto it = m_spill_allocs.find(p);
+    if (it != m_spill_allocs.end()) {
+        munmap(p, it->second);
+        m_spill_allocs.erase(it);
+        return true;
+    }
+#else
+    amrex::ignore_unused(p);
+#endif
+    return false;
+}
+
+std::size_t
+Arena::hugepage_backed_bytes () const
+{
+    std::size_t nbytes = 0;
+#if defined(__linux__)
+    Vector<std::pair<std::uintptr_t,std::uintptr_t>> thp_ranges;
+    for (auto const& [p, a] : m_hugepage_allocs) {
+        if (a.hugetlb) {
+            nbytes += a.nbytes;
+        } else {
+            auto lo = reinterpret_cast<std::uintptr_t>(p);
+            thp_ranges.emplace_back(lo, lo+a.nbytes);
+        }
+    }
+
+    if (!thp_ranges.empty()) {
+        // The kernel may merge our mappings with neighboring ones, so the
+        // AnonHugePages of a mapping is split in proportion to the overlap.
+        std::ifstream ifs("/proc/self/smaps");
+        std::string line;
+        std::uintptr_t lo = 0, hi = 0;
+        while (std::getline(ifs, line)) {
+            auto dash = line.find('-');
+            auto space = line.find(' ');
+            if (!line.empty() && std::isxdigit(line[0]) && !std::isupper(line[0])
+                && dash != std::string::npos && dash < space)
+            {
+                lo = std::stoull(line.substr(0, dash), nullptr, 16);
+                hi = std::stoull(line.substr(dash+1, space-dash-1), nullptr, 16);
+            }
+            else if (line.compare(0, 14, "AnonHugePages:") == 0 && hi > lo)
+            {
+                const auto kb = std::stoull(line.substr(14));
+                if (kb == 0) { continue; }
+                std::uintptr_t overlap = 0;
+                for (auto const& r : thp_ranges) {
+                    auto olo = std::max(lo, r.first);
+                    auto ohi = std::min(hi, r.second);
+                    if (ohi > olo) { overlap += ohi - olo; }
+                }
+                nbytes += static_cast<std::size_t>(double(kb*1024) * double(overlap) / double(hi-lo));
+            }
+        }
+    }
+#endif
+    return nbytes;
+}
+
 namespace {
 
     class NullArena final
@@ -288,6 +536,9 @@ Arena::Initialize ()
     // see reason on allowed reuse of the default CPU BArena in Arena::Finalize
     BL_ASSERT(the_arena == nullptr || the_arena == The_BArena());
     BL_ASSERT(the_async_arena == nullptr);
+    BL_ASSERT(the_bump_arena == nullptr);
+    BL_ASSERT(the_recycle_arena == nullptr);
+    BL_ASSERT(the_spill_arena == nullptr);
     BL_ASSERT(the_device_arena == nullptr || the_device_arena == The_BArena());
     BL_ASSERT(the_managed_arena == nullptr || the_managed_arena == The_BArena());
     BL_ASSERT(the_pinned_arena == nullptr);
@@ -314,22 +565,44 @@ Arena::Initialize ()
     pp.queryAdd( "the_pinned_arena_release_threshold",  the_pinned_arena_release_threshold);
     pp.queryAdd("the_comms_arena_release_threshold", the_comms_arena_release_threshold);
     pp.queryAdd(  "the_async_arena_release_threshold",   the_async_arena_release_threshold);
+    pp.queryAdd("the_arena_thread_cache_size", the_arena_thread_cache_size);
+    pp.queryAdd("the_arena_thread_cache_max_block", the_arena_thread_cache_max_block);
     pp.queryAdd("the_arena_is_managed", the_arena_is_managed);
+    pp.queryAdd("the_arena_numa", the_arena_numa);
+    pp.queryAdd("the_arena_numa_interleave", the_arena_numa_interleave);
+    pp.queryAdd("the_arena_use_hugepages", the_arena_use_hugepages);
+    pp.queryAdd("the_arena_hugepage_size", the_arena_hugepage_size);
+    pp.queryAdd("the_arena_diagnostics", the_arena_diagnostics);
+    pp.queryAdd("use_bump_arena", use_bump_arena);
+    pp.queryAdd("the_bump_arena_chunk_size", the_bump_arena_chunk_size);
+    pp.queryAdd("use_recycle_arena", use_recycle_arena);
+    pp.queryAdd("the_spill_arena_dir", the_spill_arena_dir);
+    pp.queryAdd("the_spill_arena_advice", the_spill_arena_advice);
     pp.queryAdd("abort_on_out_of_gpu_memory", abort_on_out_of_gpu_memory);
 
     {
+        // The hunks must be at least as big as explicit huge pages.
+        const auto hunk_size = std::max(CArena::DefaultHunkSize,
+                                        static_cast<std::size_t>(the_arena_hugepage_size));
 #if defined(BL_COALESCE_FABS) || defined(AMREX_USE_GPU)
         ArenaInfo ai{};
         ai.SetReleaseThreshold(the_arena_release_threshold);
+        ai.SetThreadCache(the_arena_thread_cache_size, the_arena_thread_cache_max_block);
+        if (the_arena_use_hugepages) {
+            ai.SetHugePages(the_arena_hugepage_size);
+        }
+        if (the_arena_diagnostics) {
+            ai.SetDiagnostics();
+        }
         if (the_arena_is_managed) {
-            the_arena = new CArena(0, ai.SetPreferred());
+            the_arena = new CArena(hunk_size, ai.SetPreferred());
 #ifdef AMREX_USE_GPU
             the_arena->registerForProfiling("Managed Memory");
 #else
             the_arena->registerForProfiling("Cpu Memory");
 #endif
         } else {
-            the_arena = new CArena(0, ai.SetDeviceMemory());
+            the_arena = new CArena(hunk_size, ai.SetDeviceMemory());
 #ifdef AMREX_USE_GPU
             the_arena->registerForProfiling("Device Memory");
 #else
@@ -342,13 +615,42 @@ Arena::Initialize ()
         the_arena->free(p);
 #endif
 #else
-        the_arena = The_BArena();
+        ArenaInfo ai{};
+        ai.SetReleaseThreshold(the_arena_release_threshold);
+        ai.SetThreadCache(the_arena_thread_cache_size, the_arena_thread_cache_max_block);
+        if (the_arena_use_hugepages) {
+            ai.SetHugePages(the_arena_hugepage_size);
+        }
+        if (the_arena_diagnostics) {
+            ai.SetDiagnostics();
+        }
+        if (the_arena_numa) {
+            the_arena = new NumaArena(the_arena_numa_interleave, hunk_size, ai);
+            the_arena->registerForProfiling("Cpu Memory");
+        } else if (the_arena_use_hugepages || the_arena_diagnostics ||
+                   the_arena_thread_cache_size > 0) {
+            // These are features of CArena.
+            the_arena = new CArena(hunk_size, ai);
+            the_arena->registerForProfiling("Cpu Memory");
+        } else {
+            the_arena = The_BArena();
+        }
 #endif
     }
 
     the_async_arena = new PArena(the_async_arena_release_threshold);
     the_async_arena->registerForProfiling("Async Memory");
 
+#ifndef AMREX_USE_GPU
+    if (use_bump_arena) {
+        the_bump_arena = new BumpArena(the_bump_arena_chunk_size);
+    }
+#endif
+
+    if (use_recycle_arena) {
+        the_recycle_arena = new RecycleArena(the_arena);
+    }
+
 #ifdef AMREX_USE_GPU
     if (the_arena->isDevice()) {
         the_device_arena = the_arena;
@@ -423,6 +725,20 @@ Arena::Initialize ()
     the_cpu_arena = The_BArena();
     the_cpu_arena->registerForProfiling("Cpu Memory");
 
+    if (!the_spill_arena_dir.empty()) {
+        ArenaInfo::SpillAdvice advice = ArenaInfo::SpillAdvice::Normal;
+        if (the_spill_arena_advice == "sequential") {
+            advice = ArenaInfo::SpillAdvice::Sequential;
+        } else if (the_spill_arena_advice == "random") {
+            advice = ArenaInfo::SpillAdvice::Random;
+        } else if (the_spill_arena_advice != "normal") {
+            amrex::Abort("amrex.the_spill_arena_advice must be normal, sequential or random");
+        }
+        the_spill_arena = new CArena(0, ArenaInfo{}.SetCpuMemory()
+                                     .SetSpill(the_spill_arena_dir, advice));
+        the_spill_arena->registerForProfiling("Spill Memory");
+    }
+
     // Initialize the null arena
     auto* null_arena = The_Null_Arena();
     amrex::ignore_unused(null_arena);
@@ -463,6 +779,10 @@ Arena::PrintUsage ()
         if (p) {
             p->PrintUsage("The         Arena");
         }
+        auto* pn = dynamic_cast<NumaArena*>(The_Arena());
+        if (pn) {
+            pn->PrintUsage("The         Arena");
+        }
     }
     if (The_Device_Arena() && The_Device_Arena() != The_Arena()) {
         auto* p = dynamic_cast<CArena*>(The_Device_Arena());
@@ -489,6 +809,12 @@ Arena::PrintUsage ()
             p->PrintUsage("The   Comms Arena");
         }
     }
+    if (the_spill_arena) {
+        auto* p = dynamic_cast<CArena*>(the_spill_arena);
+        if (p) {
+            p->PrintUsage("The   Spill Arena");
+        }
+    }
 }
 
 void
@@ -515,6 +841,10 @@ Arena::PrintUsageToFiles (const std::string& filename, const std::string& messag
         if (p) {
             p->PrintUsage(ofs, "The         Arena", "    ");
         }
+        auto* pn = dynamic_cast<NumaArena*>(The_Arena());
+        if (pn) {
+            pn->PrintUsage(ofs, "The         Arena", "    ");
+        }
     }
     if (The_Device_Arena() && The_Device_Arena() != The_Arena()) {
         auto* p = dynamic_cast<CArena*>(The_Device_Arena());
@@ -541,10 +871,28 @@ Arena::PrintUsageToFiles (const std::string& filename, const std::string& messag
             p->PrintUsage(ofs, "The   Comms Arena", "    ");
         }
     }
+    if (the_spill_arena) {
+        auto* p = dynamic_cast<CArena*>(the_spill_arena);
+        if (p) {
+            p->PrintUsage(ofs, "The   Spill Arena", "    ");
+        }
+    }
 
     ofs << "\n";
 }
 
+void
+Arena::PrintDiagnostics ()
+{
+    if (the_arena && the_arena->arenaInfo().diagnostics) {
+        if (auto* p = dynamic_cast<CArena*>(the_arena)) {
+            p->PrintDiagnostics("The         Arena");
+        } else if (auto* pn = dynamic_cast<NumaArena*>(the_arena)) {
+            pn->PrintDiagnostics("The         Arena");
+        }
+    }
+}
+
 void
 Arena::Finalize ()
 {
@@ -556,6 +904,8 @@ Arena::Finalize ()
         PrintUsage();
     }
 
+    PrintDiagnostics();
+
     initialized = false;
 
     // we reset Arenas unless they are the default "CPU malloc/free" BArena
@@ -586,6 +936,12 @@ Arena::Finalize ()
         the_managed_arena = nullptr;
     }
 
+    // Their memory is from the_arena.
+    delete the_bump_arena;
+    the_bump_arena = nullptr;
+    delete the_recycle_arena;
+    the_recycle_arena = nullptr;
+
     if (!dynamic_cast<BArena*>(the_arena)) {
         delete the_arena;
         the_arena = nullptr;
@@ -597,6 +953,9 @@ Arena::Finalize ()
     delete the_pinned_arena;
     the_pinned_arena = nullptr;
 
+    delete the_spill_arena;
+    the_spill_arena = nullptr;
+
     if (!dynamic_cast<BArena*>(the_cpu_arena)) {
         delete the_cpu_arena;
         the_cpu_arena = nullptr;
@@ -625,6 +984,26 @@ The_Async_Arena ()
     }
 }
 
+Arena*
+The_Bump_Arena ()
+{
+    if        (the_bump_arena) {
+        return the_bump_arena;
+    } else {
+        return The_Async_Arena();
+    }
+}
+
+Arena*
+The_Recycle_Arena ()
+{
+    if        (the_recycle_arena) {
+        return the_recycle_arena;
+    } else {
+        return The_Arena();
+    }
+}
+
 Arena*
 The_Device_Arena ()
 {
@@ -665,6 +1044,16 @@ The_Cpu_Arena ()
     }
 }
 
+Arena*
+The_Spill_Arena ()
+{
+    if        (the_spill_arena) {
+        return the_spill_arena;
+    } else {
+        return The_Cpu_Arena();
+    }
+}
+
 Arena*
 The_Comms_Arena ()
 {
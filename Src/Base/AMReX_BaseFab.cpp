@@ -1,5 +1,6 @@
 #include <AMReX_BaseFab.H>
 #include <AMReX_BLFort.H>
+#include <AMReX_ParmParse.H>
 
 #ifdef AMREX_MEM_PROFILING
 #include <AMReX_MemProfiler.H>
@@ -19,6 +20,10 @@ Long private_total_bytes_allocated_in_fabs_hwm = 0L;
 Long private_total_cells_allocated_in_fabs     = 0L;
 Long private_total_cells_allocated_in_fabs_hwm = 0L;
 
+bool basefab_use_omp = false;
+Long basefab_omp_min_size = 262144L;
+Long basefab_nontemporal_min_bytes = 33554432L;
+
 namespace
 {
     bool basefab_initialized = false;
@@ -31,6 +36,11 @@ BaseFab_Initialize ()
     {
         basefab_initialized = true;
 
+        ParmParse pp("fab");
+        pp.queryAdd("use_omp", basefab_use_omp);
+        pp.queryAdd("omp_min_size", basefab_omp_min_size);
+        pp.queryAdd("nontemporal_min_bytes", basefab_nontemporal_min_bytes);
+
 #ifdef AMREX_USE_OMP
 #pragma omp parallel
         {
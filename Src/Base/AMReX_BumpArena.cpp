@@ -0,0 +1,163 @@
+#include <AMReX_BumpArena.H>
+#include <AMReX_OpenMP.H>
+
+#include <algorithm>
+#include <new>
+
+namespace amrex {
+
+BumpArena::BumpArena (std::size_t chunk_size)
+    : m_chunk_size(chunk_size > 0 ? Arena::align(chunk_size) : DefaultChunkSize),
+      m_stacks(OpenMP::get_max_threads())
+{
+    arena_info.SetCpuMemory();
+}
+
+BumpArena::~BumpArena ()
+{
+    for (auto& s : m_stacks) {
+        for (auto const& c : s.chunks) {
+            The_Arena()->free(c.p);
+        }
+    }
+}
+
+void*
+BumpArena::alloc (std::size_t nbytes)
+{
+    const std::size_t need = sizeof(Header) + Arena::align(nbytes);
+    const int tid = OpenMP::get_thread_num();
+
+    if (tid >= static_cast<int>(m_stacks.size())) {
+        // e.g., nested parallel regions
+        auto* h = new (The_Async_Arena()->alloc(need)) Header{nullptr, 0, 0, -1, {0}};
+        return h+1;
+    }
+
+    auto& s = m_stacks[tid];
+    const int cur = s.cur;
+    const std::size_t offset = s.offset;
+    if (s.cur < 0 || s.offset + need > s.chunks[s.cur].size) {
+        next_chunk(s, need);
+    }
+    auto* h = new (s.chunks[s.cur].p + s.offset) Header{s.top, offset, cur, tid, {0}};
+    s.offset += need;
+    s.top = h;
+    return h+1;
+}
+
+void
+BumpArena::free (void* vp)
+{
+    if (vp == nullptr) { return; }
+
+    auto* h = static_cast<Header*>(vp) - 1;
+    if (h->owner < 0) {
+        h->~Header();
+        The_Async_Arena()->free(h);
+        return;
+    }
+
+    h->freed.store(1, std::memory_order_release);
+    if (h->owner == OpenMP::get_thread_num()) {
+        pop(m_stacks[h->owner]);
+    }
+    // Otherwise, the owner pops it when it frees the blocks above it.
+}
+
+void
+BumpArena::pop (Stack& s) noexcept
+{
+    while (s.top && s.top->freed.load(std::memory_order_acquire)) {
+        s.cur = s.top->chunk;
+        s.offset = s.top->offset;
+        s.top = s.top->prev;
+    }
+}
+
+void
+BumpArena::next_chunk (Stack& s, std::size_t nbytes)
+{
+    const auto next = static_cast<Long>(s.cur+1);
+    if (next < s.chunks.size() && s.chunks[next].size >= nbytes) {
+        ++s.cur;
+        s.offset = 0;
+        return;
+    }
+
+    // The chunks above the top are unused.  Replace them with a big enough one.
+    for (Long i = next; i < s.chunks.size(); ++i) {
+        The_Arena()->free(s.chunks[i].p);
+    }
+    s.chunks.resize(next);
+    const std::size_t sz = std::max(m_chunk_size, nbytes);
+    s.chunks.push_back(Chunk{static_cast<char*>(The_Arena()->alloc(sz)), sz});
+    ++s.cur;
+    s.offset = 0;
+}
+
+std::size_t
+BumpArena::freeUnused ()
+{
+    std::size_t nbytes = 0;
+    for (auto& s : m_stacks) {
+        pop(s);
+        const auto next = static_cast<Long>(s.cur+1);
+        for (Long i = next; i < s.chunks.size(); ++i) {
+            nbytes += s.chunks[i].size;
+            The_Arena()->free(s.chunks[i].p);
+        }
+        s.chunks.resize(next);
+    }
+    return nbytes;
+}
+
+std::size_t
+BumpArena::heap_space_used () const noexcept
+{
+    std::size_t nbytes = 0;
+    for (auto const& s : m_stacks) {
+        for (auto const& c : s.chunks) {
+            nbytes += c.size;
+        }
+    }
+    return nbytes;
+}
+
+BumpArena::Mark
+BumpArena::mark (int tid) const noexcept
+{
+    auto const& s = m_stacks[tid];
+    return Mark{s.cur, s.offset, s.top};
+}
+
+void
+BumpArena::release (int tid, Mark const& m) noexcept
+{
+    auto& s = m_stacks[tid];
+    s.cur = m.cur;
+    s.offset = m.offset;
+    s.top = m.top;
+    // Blocks below the mark may have been freed inside the scope.
+    pop(s);
+}
+
+ArenaScope::ArenaScope (Arena* arena)
+    : m_arena(dynamic_cast<BumpArena*>(arena)),
+      m_tid(OpenMP::get_thread_num())
+{
+    if (m_arena && m_tid < static_cast<int>(m_arena->m_stacks.size())) {
+        m_mark = m_arena->mark(m_tid);
+    } else {
+        m_arena = nullptr;
+    }
+}
+
+ArenaScope::~ArenaScope ()
+{
+    if (m_arena) {
+        m_arena->release(m_tid, m_mark);
+    }
+}
+
+}
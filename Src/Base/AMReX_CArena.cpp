@@ -4,23 +4,123 @@
 #include <AMReX_Gpu.H>
 #include <AMReX_MFIter.H>
 #include <AMReX_ParallelReduce.H>
+#include <AMReX_Utility.H>
 
+#include <algorithm>
+#include <cstdint>
 #include <utility>
 #include <cstring>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 
 namespace amrex {
 
+namespace {
+    // A miss of the thread cache fetches about this many bytes from the
+    // central free list, but no more than MaxBatch blocks.
+    constexpr std::size_t BatchBytes = 32768;
+    constexpr int MaxBatch = 32;
+
+    // The thread caches of a thread, one per arena it has used.  An arena
+    // may be created at the address of a destroyed one, so an entry is
+    // matched by the address and the serial number, which is never reused.
+    struct TLCache
+    {
+        void const* arena = nullptr;
+        std::uint64_t serial = 0;
+        void* cache = nullptr;
+    };
+
+    thread_local std::vector<TLCache> tl_caches;
+
+    std::atomic<std::uint64_t> carena_serial{0};
+
+    // The serial numbers of the arenas that have not been destroyed, used
+    // to remove the entries of destroyed arenas from tl_caches.
+    std::mutex& live_serials_mutex ()
+    {
+        static std::mutex m;
+        return m;
+    }
+
+    std::unordered_set<std::uint64_t>& live_serials ()
+    {
+        static std::unordered_set<std::uint64_t> s;
+        return s;
+    }
+
+    int size_class (std::size_t nbytes) noexcept
+    {
+        int k = 0;
+        for (std::size_t sz = CArena::ThreadCacheMinBlock; sz < nbytes; sz *= 2) {
+            ++k;
+        }
+        return k;
+    }
+
+    std::size_t class_size (int k) noexcept
+    {
+        return CArena::ThreadCacheMinBlock << k;
+    }
+
+    void print_table (std::ostream& os, std::string const& space,
+                      std::vector<std::vector<std::string>> const& rows)
+    {
+        std::vector<std::size_t> maxlen(rows[0].size(), 0);
+        for (auto const& row : rows) {
+            for (std::size_t i = 0; i < maxlen.size(); ++i) {
+                maxlen[i] = std::max(maxlen[i], row[i].size());
+            }
+        }
+        for (std::size_t i = 1; i < maxlen.size(); ++i) {
+            maxlen[i] += 2;
+        }
+        for (auto const& row : rows) {
+            os << space << "    " << std::left << std::setw(int(maxlen[0])) << row[0];
+            for (std::size_t i = 1; i < maxlen.size(); ++i) {
+                os << std::right << std::setw(int(maxlen[i])) << row[i];
+            }
+            os << "\n";
+        }
+    }
+
+    std::string to_string (double x)
+    {
+        std::ostringstream ss;
+        ss << std::setprecision(4) << x;
+        return ss.str();
+    }
+
+    std::string to_megabytes (double nbytes)
+    {
+        return to_string(nbytes / (1024.*1024.));
+    }
+
+}
+
 CArena::CArena (std::size_t hunk_size, ArenaInfo info)
-    : m_hunk(align(hunk_size == 0 ? DefaultHunkSize : hunk_size))
+    : m_hunk(align(hunk_size == 0 ? DefaultHunkSize : hunk_size)),
+      m_serial(++carena_serial)
 {
     arena_info = info;
     BL_ASSERT(m_hunk >= hunk_size);
     BL_ASSERT(m_hunk%Arena::align_size == 0);
+
+    if (arena_info.thread_cache_size > 0 && arena_info.thread_cache_max_block > 0) {
+        m_tcache_max_bytes = arena_info.thread_cache_size;
+        m_tcache_max_block = class_size(size_class(arena_info.thread_cache_max_block));
+        std::lock_guard<std::mutex> lock(live_serials_mutex());
+        live_serials().insert(m_serial);
+    }
 }
 
 CArena::~CArena ()
 {
+    if (m_tcache_max_bytes > 0) {
+        std::lock_guard<std::mutex> lock(live_serials_mutex());
+        live_serials().erase(m_serial);
+    }
     for (auto const& a : m_alloc) {
         deallocate_system(a.first, a.second);
     }
@@ -29,11 +129,245 @@ CArena::~CArena ()
 void*
 CArena::alloc (std::size_t nbytes)
 {
-    std::lock_guard<std::mutex> lock(carena_mutex);
     nbytes = Arena::align(nbytes == 0 ? 1 : nbytes);
+    if (use_thread_cache(nbytes)) {
+        return alloc_cached(nbytes);
+    }
+    std::lock_guard<std::mutex> lock(carena_mutex);
     return alloc_protected(nbytes);
 }
 
+bool
+CArena::use_thread_cache (std::size_t nbytes) const noexcept
+{
+#ifdef AMREX_TINY_PROFILING
+    // The memory profiler needs to see every allocation.
+    if (m_profiler.m_do_profiling) { return false; }
+#endif
+    if (arena_info.diagnostics) { return false; }
+    return m_tcache_max_bytes > 0 && nbytes <= m_tcache_max_block;
+}
+
+CArena::ThreadCache*
+CArena::find_thread_cache () const noexcept
+{
+    for (auto const& entry : tl_caches) {
+        if (entry.arena == this && entry.serial == m_serial) {
+            return static_cast<ThreadCache*>(entry.cache);
+        }
+    }
+    return nullptr;
+}
+
+CArena::ThreadCache&
+CArena::thread_cache ()
+{
+    if (auto* tc = find_thread_cache()) { return *tc; }
+
+    // The first use by this thread.  Remove the entries of destroyed arenas.
+    {
+        std::lock_guard<std::mutex> lock(live_serials_mutex());
+        auto const& live = live_serials();
+        tl_caches.erase(std::remove_if(tl_caches.begin(), tl_caches.end(),
+                                       [&] (TLCache const& entry)
+                                       { return live.count(entry.serial) == 0; }),
+                        tl_caches.end());
+    }
+
+    // The cache may exist if a thread with the same id has exited.
+    ThreadCache* tc = nullptr;
+    {
+        const auto id = std::this_thread::get_id();
+        std::lock_guard<std::mutex> lock(m_tcache_mutex);
+        for (auto const& c : m_tcache) {
+            if (c->thread == id) { tc = c.get(); }
+        }
+        if (tc == nullptr) {
+            m_tcache.push_back(std::make_unique<ThreadCache>());
+            tc = m_tcache.back().get();
+            tc->bins.resize(size_class(m_tcache_max_block)+1);
+            tc->thread = id;
+        }
+    }
+    tl_caches.push_back(TLCache{this, m_serial, tc});
+    return *tc;
+}
+
+void
+CArena::push_remote (ThreadCache& tc, void* vp) noexcept
+{
+    void* head = tc.remote.load(std::memory_order_relaxed);
+    do {
+        *static_cast<void**>(vp) = head;
+    } while (!tc.remote.compare_exchange_weak(head, vp, std::memory_order_release,
+                                              std::memory_order_relaxed));
+}
+
+void*
+CArena::alloc_cached (std::size_t nbytes)
+{
+    const int k = size_class(nbytes);
+    const std::size_t sz = class_size(k);
+
+    auto& tc = thread_cache();
+    std::lock_guard<std::mutex> tc_lock(tc.mutex);
+    auto& bin = tc.bins[k];
+    if (bin.empty()) {
+        drain_remote(tc);
+    }
+    if (!bin.empty()) {
+        void* p = bin.back();
+        bin.pop_back();
+        tc.nbytes.store(tc.nbytes.load(std::memory_order_relaxed) - sz, std::memory_order_relaxed);
+        return p;
+    }
+
+    // Miss. Fetch a batch of blocks from the central free list.
+    const int nbatch = std::clamp(static_cast<int>(BatchBytes/sz), 1, MaxBatch);
+    std::vector<void*> blocks(nbatch);
+    {
+        std::lock_guard<std::mutex> lock(carena_mutex);
+        for (auto& p : blocks) {
+            p = alloc_protected(sz);
+            // The cache is not part of the ordering.
+            auto busy_it = m_busylist.find(Node(p,nullptr,0));
+            const_cast<Node&>(*busy_it).cache(&tc);
+        }
+    }
+
+    for (auto* p : blocks) {
+        tc.blocks.emplace(p, k);
+    }
+
+    if (nbatch > 1) {
+        // Hand out the lowest address first.
+        bin.insert(bin.end(), blocks.rbegin(), blocks.rend()-1);
+        tc.nbytes.store(tc.nbytes.load(std::memory_order_relaxed) + (nbatch-1)*sz,
+                        std::memory_order_relaxed);
+        if (tc.nbytes.load(std::memory_order_relaxed) > m_tcache_max_bytes) {
+            std::vector<void*> released;
+            trim_thread_cache(tc, released);
+            release_cached(tc, released);
+        }
+    }
+
+    return blocks[0];
+}
+
+void
+CArena::drain_remote (ThreadCache& tc)
+{
+    void* p = tc.remote.exchange(nullptr, std::memory_order_acquire);
+    std::size_t nbytes = 0;
+    while (p != nullptr) {
+        void* next = *static_cast<void**>(p);
+        const int k = tc.blocks.at(p);
+        tc.bins[k].push_back(p);
+        nbytes += class_size(k);
+        p = next;
+    }
+    if (nbytes > 0) {
+        tc.nbytes.store(tc.nbytes.load(std::memory_order_relaxed) + nbytes,
+                        std::memory_order_relaxed);
+    }
+}
+
+void
+CArena::trim_thread_cache (ThreadCache& tc, std::vector<void*>& released) const
+{
+    const std::size_t target = m_tcache_max_bytes / 2;
+    std::size_t nbytes = tc.nbytes.load(std::memory_order_relaxed);
+    // Start with the largest size class, so that as few blocks as possible are moved.
+    for (int k = static_cast<int>(tc.bins.size())-1; k >= 0 && nbytes > target; --k) {
+        auto& bin = tc.bins[k];
+        const std::size_t sz = class_size(k);
+        const std::size_t n = std::min(bin.size(), (nbytes-target+sz-1)/sz);
+        // The front of the bin is the least recently freed.
+        released.insert(released.end(), bin.begin(), bin.begin()+n);
+        bin.erase(bin.begin(), bin.begin()+n);
+        nbytes -= n*sz;
+    }
+    tc.nbytes.store(nbytes, std::memory_order_relaxed);
+}
+
+bool
+CArena::free_cached (void* vp)
+{
+    auto* ptc = find_thread_cache();
+    if (ptc == nullptr) { return false; }
+    auto& tc = *ptc;
+    std::lock_guard<std::mutex> tc_lock(tc.mutex);
+    auto it = tc.blocks.find(vp);
+    if (it != tc.blocks.end()) {
+        const int k = it->second;
+        tc.bins[k].push_back(vp);
+        const std::size_t nbytes = tc.nbytes.load(std::memory_order_relaxed) + class_size(k);
+        tc.nbytes.store(nbytes, std::memory_order_relaxed);
+        if (nbytes > m_tcache_max_bytes) {
+            std::vector<void*> released;
+            trim_thread_cache(tc, released);
+            release_cached(tc, released);
+        }
+        return true;
+    }
+    return false;
+}
+
+void
+CArena::release_cached (ThreadCache& tc, std::vector<void*> const& blocks)
+{
+    if (blocks.empty()) { return; }
+
+    for (auto* p : blocks) {
+        tc.blocks.erase(p);
+    }
+
+    std::lock_guard<std::mutex> lock(carena_mutex);
+    for (auto* p : blocks) {
+        auto busy_it = m_busylist.find(Node(p,nullptr,0));
+        AMREX_ASSERT(busy_it != m_busylist.end() && busy_it->cache() == &tc);
+        free_busy(busy_it);
+    }
+}
+
+void
+CArena::flush_thread_cache (ThreadCache& tc)
+{
+    drain_remote(tc);
+    std::vector<void*> released;
+    for (auto& bin : tc.bins) {
+        released.insert(released.end(), bin.begin(), bin.end());
+        bin.clear();
+    }
+    tc.nbytes.store(0, std::memory_order_relaxed);
+    release_cached(tc, released);
+}
+
+void
+CArena::flush_thread_caches ()
+{
+    if (m_tcache_max_bytes == 0) { return; }
+
+    // The other threads may be using their caches, which are protected by
+    // their mutexes.
+    std::lock_guard<std::mutex> lock(m_tcache_mutex);
+    for (auto const& tc : m_tcache) {
+        std::lock_guard<std::mutex> tc_lock(tc->mutex);
+        flush_thread_cache(*tc);
+    }
+}
+
+std::size_t
+CArena::thread_cache_bytes () const noexcept
+{
+    std::size_t nbytes = 0;
+    std::lock_guard<std::mutex> lock(m_tcache_mutex);
+    for (auto const& tc : m_tcache) {
+        nbytes += tc->nbytes.load(std::memory_order_relaxed);
+    }
+    return nbytes;
+}
+
 void*
 CArena::alloc_protected (std::size_t nbytes)
 {
@@ -120,16 +454,24 @@ CArena::alloc_protected (std::size_t nbytes)
 
     BL_ASSERT(vp != nullptr);
 
+    if (arena_info.diagnostics) {
+        diag_alloc(vp, nbytes);
+    }
+
     return vp;
 }
 
 std::pair<void*,std::size_t>
 CArena::alloc_in_place (void* pt, std::size_t szmin, std::size_t szmax)
 {
-    std::lock_guard<std::mutex> lock(carena_mutex);
-
     std::size_t nbytes_max = Arena::align(szmax == 0 ? 1 : szmax);
 
+    if (pt == nullptr && use_thread_cache(nbytes_max)) {
+        return std::make_pair(alloc_cached(nbytes_max), nbytes_max);
+    }
+
+    std::lock_guard<std::mutex> lock(carena_mutex);
+
     if (pt != nullptr) { // Try to allocate in-place first
         auto busy_it = m_busylist.find(Node(pt,nullptr,0));
         if (busy_it == m_busylist.end()) {
@@ -142,6 +484,16 @@ CArena::alloc_in_place (void* pt, std::size_t szmin, std::size_t szmax)
             return std::make_pair(pt, busy_it->size());
         }
 
+        // A block of the thread caches cannot grow, because it could not
+        // go back to its size class.
+        if (busy_it->cache() != nullptr) {
+            if (busy_it->size() >= szmin) {
+                return std::make_pair(pt, busy_it->size());
+            } else {
+                return std::make_pair(alloc_protected(nbytes_max), nbytes_max);
+            }
+        }
+
         void* next_block = (char*)pt + busy_it->size();
         auto next_it = m_freelist.find(Node(next_block,nullptr,0));
         if (next_it != m_freelist.end() && busy_it->coalescable(*next_it)) {
@@ -168,6 +520,9 @@ CArena::alloc_in_place (void* pt, std::size_t szmin, std::size_t szmax)
 #endif
                 m_actually_used += new_size - busy_it->size();
                 const_cast<Node&>(*busy_it).size(new_size);
+                if (arena_info.diagnostics) {
+                    diag_resize(pt, new_size);
+                }
                 return std::make_pair(pt, new_size);
             } else if (total_size >= szmin) {
                 m_freelist.erase(next_it);
@@ -181,6 +536,9 @@ CArena::alloc_in_place (void* pt, std::size_t szmin, std::size_t szmax)
 #endif
                 m_actually_used += total_size - busy_it->size();
                 const_cast<Node&>(*busy_it).size(total_size);
+                if (arena_info.diagnostics) {
+                    diag_resize(pt, total_size);
+                }
                 return std::make_pair(pt, total_size);
             }
         }
@@ -210,6 +568,9 @@ CArena::shrink_in_place (void* pt, std::size_t new_size)
     }
     AMREX_ASSERT(m_freelist.find(*busy_it) == m_freelist.end());
 
+    // A block of the thread caches keeps its size class.
+    if (busy_it->cache() != nullptr) { return pt; }
+
     auto const old_size = busy_it->size();
 
     if (new_size > old_size) {
@@ -240,6 +601,10 @@ CArena::shrink_in_place (void* pt, std::size_t new_size)
 
         m_actually_used -= leftover_size;
 
+        if (arena_info.diagnostics) {
+            diag_resize(pt, new_size);
+        }
+
 #ifdef AMREX_TINY_PROFILING
         if (m_profiler.m_do_profiling) {
             TinyProfiler::memory_free(old_size, busy_it->mem_stat());
@@ -262,8 +627,15 @@ CArena::free (void* vp)
         return;
     }
 
+    if (m_tcache_max_bytes > 0 && free_cached(vp)) { return; }
+
     std::lock_guard<std::mutex> lock(carena_mutex);
+    free_protected(vp);
+}
 
+void
+CArena::free_protected (void* vp)
+{
     //
     // `vp' had better be in the busy list.
     //
@@ -272,10 +644,29 @@ CArena::free (void* vp)
         amrex::Abort("CArena::free: unknown pointer");
         return;
     }
+
+    if (busy_it->cache() != nullptr) {
+        // A block of the cache of another thread.  Its owner takes it back.
+        push_remote(*static_cast<ThreadCache*>(busy_it->cache()), vp);
+        return;
+    }
+
+    free_busy(busy_it);
+}
+
+void
+CArena::free_busy (std::unordered_set<Node, Node::hash>::iterator busy_it)
+{
     BL_ASSERT(m_freelist.find(*busy_it) == m_freelist.end());
 
+    void* vp = busy_it->block();
+
     m_actually_used -= busy_it->size();
 
+    if (arena_info.diagnostics) {
+        diag_free(vp);
+    }
+
 #ifdef AMREX_TINY_PROFILING
     TinyProfiler::memory_free(busy_it->size(), busy_it->mem_stat());
 #endif
@@ -283,7 +674,9 @@ CArena::free (void* vp)
     //
     // Put free'd block on free list and save iterator to insert()ed position.
     //
-    std::pair<NL::iterator,bool> pair_it = m_freelist.insert(*busy_it);
+    Node free_node = *busy_it;
+    free_node.cache(nullptr);
+    std::pair<NL::iterator,bool> pair_it = m_freelist.insert(free_node);
 
     BL_ASSERT(pair_it.second == true);
 
@@ -345,6 +738,7 @@ CArena::free (void* vp)
 std::size_t
 CArena::freeUnused ()
 {
+    flush_thread_caches();
     std::lock_guard<std::mutex> lock(carena_mutex);
     return freeUnused_protected();
 }
@@ -417,6 +811,254 @@ CArena::hasFreeDeviceMemory (std::size_t sz)
     }
 }
 
+void
+CArena::diag_alloc (void* vp, std::size_t nbytes)
+{
+#ifdef AMREX_TINY_PROFILING
+    auto const& name = TinyProfiler::CurrentFunction();
+#else
+    static const std::string name("All");
+#endif
+    auto& site = m_diag_sites[name];
+    ++site.nalloc;
+    site.bytes += static_cast<double>(nbytes);
+    site.max_size = std::max(site.max_size, nbytes);
+    ++site.nlive;
+    site.live_bytes += nbytes;
+    m_diag_blocks[vp] = DiagBlock{&site, nbytes, amrex::second()};
+
+    if (m_actually_used > m_diag_max_used) {
+        m_diag_max_used = m_actually_used;
+        // The snapshot is taken at every new high-water mark so that it is
+        // exact.  This costs a walk over the free list and the regions.
+        m_diag_hwm.used = m_actually_used;
+        m_diag_hwm.heap = m_used;
+        m_diag_hwm.largest_free = largest_free_block();
+        m_diag_hwm.fragmentation = fragmentation();
+        m_diag_hwm.time = amrex::second();
+        m_diag_hwm.live.clear();
+        for (auto const& [sname, s] : m_diag_sites) {
+            if (s.nlive > 0) {
+                m_diag_hwm.live.emplace_back(sname, s.nlive, s.live_bytes);
+            }
+        }
+    }
+}
+
+void
+CArena::diag_free (void* vp)
+{
+    auto it = m_diag_blocks.find(vp);
+    if (it == m_diag_blocks.end()) { return; }
+    auto& b = it->second;
+    const double lifetime = amrex::second() - b.t_alloc;
+    ++(b.site->nfree);
+    --(b.site->nlive);
+    b.site->live_bytes -= b.size;
+    b.site->lifetime += lifetime;
+    b.site->max_lifetime = std::max(b.site->max_lifetime, lifetime);
+    m_diag_blocks.erase(it);
+}
+
+void
+CArena::diag_resize (void* vp, std::size_t nbytes)
+{
+    auto it = m_diag_blocks.find(vp);
+    if (it == m_diag_blocks.end()) { return; }
+    auto& b = it->second;
+    b.site->live_bytes = b.site->live_bytes - b.size + nbytes;
+    b.site->max_size = std::max(b.site->max_size, nbytes);
+    b.size = nbytes;
+    m_diag_max_used = std::max(m_diag_max_used, m_actually_used);
+}
+
+std::size_t
+CArena::largest_free_block () const noexcept
+{
+    std::size_t r = 0;
+    for (auto const& node : m_freelist) {
+        r = std::max(r, node.size());
+    }
+    return r;
+}
+
+double
+CArena::fragmentation () const noexcept
+{
+    std::size_t total = 0, largest = 0;
+    for (auto const& node : m_freelist) {
+        total += node.size();
+        largest = std::max(largest, node.size());
+    }
+    return (total > 0) ? 1.0 - static_cast<double>(largest)/static_cast<double>(total) : 0.0;
+}
+
+void
+CArena::diag_print_sites (std::ostream& os, std::string const& space,
+                          std::map<std::string, DiagSite> const& site_map)
+{
+    std::vector<std::pair<std::string,DiagSite>> sites(site_map.begin(), site_map.end());
+    std::sort(sites.begin(), sites.end(), [] (auto const& a, auto const& b)
+              { return a.second.bytes > b.second.bytes; });
+    std::vector<std::vector<std::string>> rows;
+    rows.push_back({"Region", "Allocs", "Avg size", "Max size", "Avg lifetime", "Max lifetime",
+                    "Live", "Live MB"});
+    for (auto const& [sname, s] : sites) {
+        if (s.nalloc == 0) { continue; }
+        rows.push_back({sname, std::to_string(s.nalloc),
+                        std::to_string(static_cast<Long>(s.bytes/double(s.nalloc))),
+                        std::to_string(s.max_size),
+                        (s.nfree > 0) ? to_string(s.lifetime/double(s.nfree)) : std::string("-"),
+                        (s.nfree > 0) ? to_string(s.max_lifetime) : std::string("-"),
+                        std::to_string(s.nlive), to_megabytes(double(s.live_bytes))});
+    }
+    print_table(os, space, rows);
+}
+
+void
+CArena::diag_print_hwm (std::ostream& os, std::string const& space) const
+{
+    auto live = m_diag_hwm.live;
+    std::sort(live.begin(), live.end(), [] (auto const& a, auto const& b)
+              { return std::get<2>(a) > std::get<2>(b); });
+    std::vector<std::vector<std::string>> rows;
+    rows.push_back({"Region", "Blocks", "MB", "Percent"});
+    for (auto const& [sname, n, nbytes] : live) {
+        rows.push_back({sname, std::to_string(n), to_megabytes(double(nbytes)),
+                        to_string(100.*double(nbytes)/double(std::max(m_diag_hwm.used,std::size_t(1))))});
+    }
+    os << "live allocations at the high-water mark ("
+       << to_megabytes(double(m_diag_hwm.used)) << " MB used, "
+       << to_megabytes(double(m_diag_hwm.heap)) << " MB allocated, fragmentation "
+       << to_string(m_diag_hwm.fragmentation) << ", largest free block "
+       << to_megabytes(double(m_diag_hwm.largest_free)) << " MB, at "
+       << to_string(m_diag_hwm.time) << " s):\n";
+    print_table(os, space, rows);
+}
+
+void
+CArena::PrintDiagnostics (std::ostream& os, std::string const& name, std::string const& space) const
+{
+    if (!arena_info.diagnostics) { return; }
+
+    os << space << "[" << name << "] high-water mark of space used (MB): "
+       << to_megabytes(double(m_diag_max_used)) << "\n";
+    os << space << "[" << name << "] fragmentation: " << to_string(fragmentation())
+       << ", largest free block (MB): " << to_megabytes(double(largest_free_block()))
+       << ", free blocks: " << m_freelist.size() << "\n";
+
+    os << space << "[" << name << "] allocations by region (sizes in bytes, lifetimes in seconds):\n";
+    diag_print_sites(os, space, m_diag_sites);
+
+    os << space << "[" << name << "] ";
+    diag_print_hwm(os, space);
+}
+
+void
+CArena::PrintDiagnostics (std::string const& name) const
+{
+    if (!arena_info.diagnostics) { return; }
+
+    const int IOProc = ParallelDescriptor::IOProcessorNumber();
+    MPI_Comm comm = ParallelDescriptor::Communicator();
+
+    double hwm_min = double(m_diag_max_used);
+    double hwm_max = hwm_min;
+    double frag_min = fragmentation();
+    double frag_max = frag_min;
+    double free_min = double(largest_free_block());
+    double free_max = free_min;
+    ParallelReduce::Min<double>({hwm_min, frag_min, free_min}, IOProc, comm);
+    ParallelReduce::Max<double>({hwm_max, frag_max, free_max}, IOProc, comm);
+
+    // The regions may differ among the processes.
+    std::map<std::string, DiagSite> sites = m_diag_sites;
+    {
+        Vector<std::string> local_names, synced_names;
+        bool already_synced;
+        for (auto const& kv : sites) {
+            local_names.push_back(kv.first);
+        }
+        amrex::SyncStrings(local_names, synced_names, already_synced);
+        if (!already_synced) {
+            for (auto const& sname : synced_names) {
+                sites.try_emplace(sname);
+            }
+        }
+    }
+
+    // Sums and maxima over the processes.  Every process has the same
+    // regions in the same order now.
+    std::vector<Long> nsum;
+    std::vector<double> dsum;
+    std::vector<double> dmax;
+    for (auto const& kv : sites) {
+        auto const& s = kv.second;
+        nsum.insert(nsum.end(), {s.nalloc, s.nfree, s.nlive});
+        dsum.insert(dsum.end(), {s.bytes, s.lifetime, double(s.live_bytes)});
+        dmax.insert(dmax.end(), {double(s.max_size), s.max_lifetime});
+    }
+    ParallelReduce::Sum(nsum.data(), static_cast<int>(nsum.size()), IOProc, comm);
+    ParallelReduce::Sum(dsum.data(), static_cast<int>(dsum.size()), IOProc, comm);
+    ParallelReduce::Max(dmax.data(), static_cast<int>(dmax.size()), IOProc, comm);
+    int i = 0;
+    for (auto& kv : sites) {
+        auto& s = kv.second;
+        s.nalloc = nsum[3*i];
+        s.nfree = nsum[3*i+1];
+        s.nlive = nsum[3*i+2];
+        s.bytes = dsum[3*i];
+        s.lifetime = dsum[3*i+1];
+        s.live_bytes = static_cast<std::size_t>(dsum[3*i+2]);
+        s.max_size = static_cast<std::size_t>(dmax[2*i]);
+        s.max_lifetime = dmax[2*i+1];
+        ++i;
+    }
+
+    // The live allocations at the high-water mark of the process with the
+    // highest one, which is the process most likely to run out of memory.
+    ValLocPair<Long,int> hwm{static_cast<Long>(m_diag_hwm.used), ParallelDescriptor::MyProc()};
+    ParallelAllReduce::Max(hwm, comm);
+    std::string hwm_table;
+    if (hwm.index == ParallelDescriptor::MyProc()) {
+        std::ostringstream ss;
+        diag_print_hwm(ss, "");
+        hwm_table = ss.str();
+    }
+    if (hwm.index != IOProc) {
+        auto n = static_cast<Long>(hwm_table.size());
+        ParallelDescriptor::Bcast(&n, 1, hwm.index, comm);
+        hwm_table.resize(n);
+        ParallelDescriptor::Bcast(hwm_table.data(), n, hwm.index, comm);
+    }
+
+    if (ParallelDescriptor::IOProcessor()) {
+        std::ostringstream os;
+#ifdef AMREX_USE_MPI
+        os << "[" << name << "] high-water mark of space used (MB) spread across MPI: ["
+           << to_megabytes(hwm_min) << " ... " << to_megabytes(hwm_max) << "]\n"
+           << "[" << name << "] fragmentation spread across MPI: ["
+           << to_string(frag_min) << " ... " << to_string(frag_max) << "]\n"
+           << "[" << name << "] largest free block (MB) spread across MPI: ["
+           << to_megabytes(free_min) << " ... " << to_megabytes(free_max) << "]\n";
+        os << "[" << name << "] allocations by region summed over MPI"
+           << " (sizes in bytes, lifetimes in seconds):\n";
+        diag_print_sites(os, "", sites);
+        os << "[" << name << "] process " << hwm.index << ": ";
+#else
+        os << "[" << name << "] high-water mark of space used (MB): "
+           << to_megabytes(hwm_max) << "\n"
+           << "[" << name << "] fragmentation: " << to_string(frag_max)
+           << ", largest free block (MB): " << to_megabytes(free_max) << "\n";
+        os << "[" << name << "] allocations by region (sizes in bytes, lifetimes in seconds):\n";
+        diag_print_sites(os, "", sites);
+        os << "[" << name << "] ";
+#endif
+        os << hwm_table;
+        amrex::Print() << os.str();
+    }
+}
+
 std::size_t
 CArena::heap_space_used () const noexcept
 {
@@ -429,6 +1071,12 @@ CArena::heap_space_actually_used () const noexcept
     return m_actually_used;
 }
 
+std::size_t
+CArena::heap_space_hugepage_backed () const
+{
+    return hugepage_backed_bytes();
+}
+
 std::size_t
 CArena::sizeOf (void* p) const noexcept
 {
@@ -465,6 +1113,18 @@ CArena::PrintUsage (std::string const& name) const
     amrex::Print() << "[" << name << "] space allocated (MB): " << min_megabytes << "\n";
     amrex::Print() << "[" << name << "] space used      (MB): " << actual_min_megabytes << "\n";
 #endif
+    if (arena_info.use_hugepages) {
+        Long huge_min_megabytes = static_cast<Long>(heap_space_hugepage_backed() / (1024*1024));
+        Long huge_max_megabytes = huge_min_megabytes;
+        ParallelReduce::Min<Long>(huge_min_megabytes, IOProc, ParallelDescriptor::Communicator());
+        ParallelReduce::Max<Long>(huge_max_megabytes, IOProc, ParallelDescriptor::Communicator());
+#ifdef AMREX_USE_MPI
+        amrex::Print() << "[" << name << "] space (MB) in huge pages spread across MPI: ["
+                       << huge_min_megabytes << " ... " << huge_max_megabytes << "]\n";
+#else
+        amrex::Print() << "[" << name << "] space in huge pages (MB): " << huge_min_megabytes << "\n";
+#endif
+    }
 }
 
 void
@@ -474,8 +1134,17 @@ CArena::PrintUsage (std::ostream& os, std::string const& name, std::string const
     auto actual_megabytes = heap_space_actually_used() / (1024*1024);
     os << space << "[" << name << "] space allocated (MB): " << megabytes << "\n";
     os << space << "[" << name << "] space used      (MB): " << actual_megabytes << "\n";
+    if (arena_info.use_hugepages) {
+        os << space << "[" << name << "] space in huge pages (MB): "
+           << heap_space_hugepage_backed() / (1024*1024) << "\n";
+    }
     os << space << "[" << name << "]: " << m_alloc.size() << " allocs, "
        << m_busylist.size() << " busy blocks, " << m_freelist.size() << " free blocks\n";
+    if (m_tcache_max_bytes > 0) {
+        os << space << "[" << name << "] space in thread caches (MB): "
+           << thread_cache_bytes() / (1024*1024) << "\n";
+    }
+    PrintDiagnostics(os, name, space);
 }
 
 std::ostream& operator<< (std::ostream& os, const CArena& arena)
@@ -0,0 +1,171 @@
+#include <AMReX_CTOProfile.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace amrex::CTOProfile {
+
+namespace {
+    bool initialized = false;
+    std::string profile_file;
+    int max_entries = 4;
+    double min_fraction = 0.05;
+
+    using Case = std::pair<int,int>; // ncomp, nx
+    using Counts = std::map<std::string,std::map<Case,Long>>;
+
+    Counts counts;
+    std::mutex profile_mutex;
+
+    std::string serialize (Counts const& c)
+    {
+        std::ostringstream os;
+        for (auto const& [label, m] : c) {
+            for (auto const& [cs, n] : m) {
+                os << std::quoted(label) << " " << cs.first << " " << cs.second
+                   << " " << n << "\n";
+            }
+        }
+        return os.str();
+    }
+
+    void deserialize (std::string const& s, Counts& c)
+    {
+        std::istringstream is(s);
+        std::string label;
+        while (is >> std::quoted(label)) {
+            Case cs;
+            Long n;
+            is >> cs.first >> cs.second >> n;
+            if (!is) { break; }
+            c[label][cs] += n;
+        }
+    }
+
+    // Every rank sends its counts to the I/O processor.
+    Counts gather_counts ()
+    {
+        std::string local = serialize(counts);
+        const int ioproc = ParallelDescriptor::IOProcessorNumber();
+        auto sizes = ParallelDescriptor::Gather(static_cast<int>(local.size()), ioproc);
+        std::vector<int> disp;
+        std::string all;
+        if (ParallelDescriptor::IOProcessor()) {
+            disp.resize(sizes.size(), 0);
+            for (std::size_t i = 1; i < sizes.size(); ++i) {
+                disp[i] = disp[i-1] + sizes[i-1];
+            }
+            all.resize(disp.back() + sizes.back());
+        }
+        ParallelDescriptor::Gatherv(local.data(), static_cast<int>(local.size()),
+                                    all.data(), sizes, disp, ioproc);
+        Counts r;
+        if (ParallelDescriptor::IOProcessor()) {
+            deserialize(all, r);
+        }
+        return r;
+    }
+
+    void write_header (Counts const& c)
+    {
+        std::ofstream ofs(profile_file);
+        if (!ofs) {
+            amrex::Warning("CTOProfile: cannot open " + profile_file);
+            return;
+        }
+        ofs << "// Generated by amrex::CTOProfile.  The kernel specializations of\n"
+            << "// ParallelForProfiled call sites, as CTOProfileCase<ncomp,nx>.\n\n"
+            << "namespace amrex {\n";
+        for (auto const& [label, m] : c) {
+            std::vector<std::pair<Long,Case>> sorted;
+            Long total = 0;
+            for (auto const& [cs, n] : m) {
+                sorted.emplace_back(n, cs);
+                total += n;
+            }
+            std::sort(sorted.begin(), sorted.end(),
+                      [] (auto const& a, auto const& b) { return a.first > b.first; });
+            std::vector<std::pair<Long,Case>> chosen;
+            for (auto const& x : sorted) {
+                if (static_cast<int>(chosen.size()) >= max_entries ||
+                    double(x.first) < min_fraction*double(total)) { break; }
+                chosen.push_back(x);
+            }
+            if (chosen.empty()) { continue; }
+
+            std::ostringstream quoted_label;
+            quoted_label << std::quoted(label);
+            ofs << "\n// " << quoted_label.str() << ": " << total << " calls\n"
+                << "template <>\n"
+                << "struct CTOProfileTable<detail::cto_label_hash(" << quoted_label.str() << ")>\n"
+                << "{\n"
+                << "    using type = TypeList<";
+            for (std::size_t i = 0; i < chosen.size(); ++i) {
+                ofs << (i == 0 ? "" : ",\n                          ")
+                    << "CTOProfileCase<" << chosen[i].second.first << ","
+                    << chosen[i].second.second << "> /* " << chosen[i].first << " */";
+            }
+            ofs << ">;\n};\n";
+        }
+        ofs << "\n}\n";
+
+        if (amrex::Verbose() > 0) {
+            amrex::Print() << "CTOProfile: wrote the profile of " << c.size()
+                           << " kernels to " << profile_file << "\n";
+        }
+    }
+}
+
+void
+Initialize ()
+{
+    if (initialized) { return; }
+    initialized = true;
+
+    ParmParse pp("amrex");
+    pp.queryAdd("cto_profile_file", profile_file);
+    pp.queryAdd("cto_profile_max_entries", max_entries);
+    pp.queryAdd("cto_profile_min_fraction", min_fraction);
+
+    amrex::ExecOnFinalize(CTOProfile::Finalize);
+}
+
+void
+Finalize ()
+{
+    if (!profile_file.empty()) {
+        Counts all = gather_counts();
+        if (ParallelDescriptor::IOProcessor()) {
+            write_header(all);
+        }
+    }
+    counts.clear();
+    profile_file.clear();
+    initialized = false;
+}
+
+bool
+Enabled () noexcept
+{
+    return !profile_file.empty();
+}
+
+void
+Record (const char* label, int ncomp, int nx)
+{
+    if (ncomp <= 0) { return; }
+    std::lock_guard<std::mutex> lock(profile_mutex);
+    ++counts[label][Case(ncomp,nx)];
+}
+
+}
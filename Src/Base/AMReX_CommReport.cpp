@@ -0,0 +1,329 @@
+#include <AMReX_CommReport.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_Utility.H>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+namespace amrex::CommReport {
+
+namespace {
+    bool initialized = false;
+    bool enabled = false;
+    std::string json_file;
+
+    const char* scope_name = nullptr;
+
+    struct SiteStats
+    {
+        Long ncalls = 0;
+        Long nsend = 0;        // # of messages sent
+        Long nrecv = 0;        // # of messages received
+        Long send_bytes = 0;
+        Long recv_bytes = 0;
+        Long local_bytes = 0;  // bytes copied locally
+        Long max_neighbors = 0;
+        double wait_time = 0.; // seconds
+    };
+
+    constexpr int nlong = 7; // # of Long members of SiteStats
+
+    std::map<std::string,int> site_index;
+    Vector<std::string> site_names;
+    Vector<SiteStats> site_stats;
+
+    Long num_pts (FabArrayBase::CopyComTagsContainer const& cctc)
+    {
+        Long npts = 0;
+        for (auto const& cct : cctc) {
+            npts += cct.sbox.numPts();
+        }
+        return npts;
+    }
+
+    void print_summary (Vector<std::string> const& names, Vector<Long> const& all_longs,
+                        Vector<double> const& all_waits)
+    {
+        const int nprocs = ParallelDescriptor::NProcs();
+        const auto nsites = static_cast<int>(names.size());
+
+        std::vector<std::vector<std::string>> allstatsstr;
+        allstatsstr.push_back({"Name", "Calls", "Msgs avg", "Msgs max", "Bytes avg", "Bytes max",
+                               "Local avg", "Nbrs max", "Wait avg", "Wait max"});
+
+        auto to_string = [] (double x) {
+            std::ostringstream ss;
+            ss << std::setprecision(4) << x;
+            return ss.str();
+        };
+
+        for (int isite = 0; isite < nsites; ++isite) {
+            Long ncalls = 0, nbrs_max = 0;
+            Long msgs_sum = 0, msgs_max = 0;
+            Long bytes_sum = 0, bytes_max = 0;
+            Long local_sum = 0;
+            double wait_sum = 0., wait_max = 0.;
+            for (int iproc = 0; iproc < nprocs; ++iproc) {
+                Long const* p = all_longs.data() + (std::size_t(iproc)*nsites + isite) * nlong;
+                ncalls = std::max(ncalls, p[0]);
+                msgs_sum += p[1] + p[2];
+                msgs_max = std::max(msgs_max, p[1] + p[2]);
+                bytes_sum += p[3] + p[4];
+                bytes_max = std::max(bytes_max, p[3] + p[4]);
+                local_sum += p[5];
+                nbrs_max = std::max(nbrs_max, p[6]);
+                double w = all_waits[std::size_t(iproc)*nsites + isite];
+                wait_sum += w;
+                wait_max = std::max(wait_max, w);
+            }
+            allstatsstr.push_back({names[isite], std::to_string(ncalls),
+                                   std::to_string(msgs_sum/nprocs), std::to_string(msgs_max),
+                                   std::to_string(bytes_sum/nprocs), std::to_string(bytes_max),
+                                   std::to_string(local_sum/nprocs), std::to_string(nbrs_max),
+                                   to_string(wait_sum/nprocs), to_string(wait_max)});
+        }
+
+        std::vector<int> maxlen(allstatsstr[0].size(), 0);
+        for (auto& strvec : allstatsstr) {
+            for (std::size_t i=0; i<maxlen.size(); ++i) {
+                maxlen[i] = std::max(maxlen[i], static_cast<int>(strvec[i].size()));
+            }
+        }
+        for (std::size_t i=1; i<maxlen.size(); ++i) {
+            maxlen[i] += 2;
+        }
+
+        int lenhline = 0;
+        for (auto i : maxlen) {
+            lenhline += i;
+        }
+        const std::string hline(lenhline, '-');
+
+        std::ostringstream os;
+        os << "\nCommunication report (per process numbers; Msgs and Bytes include both sends and receives,"
+           << " Local is bytes copied locally, Wait is in seconds):\n";
+        os << hline << "\n";
+        for (std::size_t i=0; i<allstatsstr.size(); ++i) {
+            os << std::left << std::setw(maxlen[0]) << allstatsstr[i][0];
+            for (std::size_t j=1; j<maxlen.size(); ++j) {
+                os << std::right << std::setw(maxlen[j]) << allstatsstr[i][j];
+            }
+            os << '\n';
+            if (i==0) {
+                os << hline << "\n";
+            }
+        }
+        os << hline << "\n";
+        amrex::Print() << os.str();
+    }
+
+    std::string json_escape (std::string const& s)
+    {
+        std::string r;
+        for (char c : s) {
+            if (c == '"' || c == '\\') { r.push_back('\\'); }
+            r.push_back(c);
+        }
+        return r;
+    }
+
+    void write_json (Vector<std::string> const& names, Vector<Long> const& all_longs,
+                     Vector<double> const& all_waits)
+    {
+        const int nprocs = ParallelDescriptor::NProcs();
+        const auto nsites = static_cast<int>(names.size());
+
+        std::ofstream ofs(json_file);
+        if (!ofs.is_open()) {
+            amrex::Warning("CommReport: failed to open "+json_file);
+            return;
+        }
+
+        const char* long_names[nlong] = {"ncalls", "nsend", "nrecv", "send_bytes", "recv_bytes",
+                                         "local_bytes", "max_neighbors"};
+
+        ofs << std::setprecision(17);
+        ofs << "{\n  \"nprocs\": " << nprocs << ",\n  \"sites\": [";
+        for (int isite = 0; isite < nsites; ++isite) {
+            ofs << ((isite == 0) ? "\n" : ",\n");
+            ofs << "    {\n      \"name\": \"" << json_escape(names[isite]) << "\"";
+            for (int m = 0; m < nlong; ++m) {
+                ofs << ",\n      \"" << long_names[m] << "\": [";
+                for (int iproc = 0; iproc < nprocs; ++iproc) {
+                    ofs << ((iproc == 0) ? "" : ", ")
+                        << all_longs[(std::size_t(iproc)*nsites + isite) * nlong + m];
+                }
+                ofs << "]";
+            }
+            ofs << ",\n      \"wait_time\": [";
+            for (int iproc = 0; iproc < nprocs; ++iproc) {
+                ofs << ((iproc == 0) ? "" : ", ") << all_waits[std::size_t(iproc)*nsites + isite];
+            }
+            ofs << "]\n    }";
+        }
+        ofs << "\n  ]\n}\n";
+    }
+}
+
+void
+Initialize ()
+{
+    if (initialized) { return; }
+    initialized = true;
+
+    ParmParse pp("fabarray");
+    pp.queryAdd("comm_report", enabled);
+    pp.queryAdd("comm_report_file", json_file);
+}
+
+void
+Finalize ()
+{
+    if (enabled)
+    {
+        // Make sure the set of call sites is the same on all processes.
+        Vector<std::string> names;
+        bool alreadySynced;
+        amrex::SyncStrings(site_names, names, alreadySynced);
+        if (alreadySynced) { names = site_names; }
+
+        const auto nsites = static_cast<int>(names.size());
+        if (nsites > 0)
+        {
+            Vector<Long> longs(std::size_t(nsites)*nlong, 0);
+            Vector<double> waits(nsites, 0.);
+            for (int isite = 0; isite < nsites; ++isite) {
+                auto it = site_index.find(names[isite]);
+                if (it != site_index.end()) {
+                    auto const& s = site_stats[it->second];
+                    Long* p = longs.data() + std::size_t(isite)*nlong;
+                    p[0] = s.ncalls;
+                    p[1] = s.nsend;
+                    p[2] = s.nrecv;
+                    p[3] = s.send_bytes;
+                    p[4] = s.recv_bytes;
+                    p[5] = s.local_bytes;
+                    p[6] = s.max_neighbors;
+                    waits[isite] = s.wait_time;
+                }
+            }
+
+            const int nprocs = ParallelDescriptor::NProcs();
+            const int ioproc = ParallelDescriptor::IOProcessorNumber();
+            Vector<Long> all_longs;
+            Vector<double> all_waits;
+            if (ParallelDescriptor::IOProcessor()) {
+                all_longs.resize(longs.size()*nprocs);
+                all_waits.resize(waits.size()*nprocs);
+            }
+            ParallelDescriptor::Gather(longs.data(), longs.size(), all_longs.data(), longs.size(), ioproc);
+            ParallelDescriptor::Gather(waits.data(), waits.size(), all_waits.data(), waits.size(), ioproc);
+
+            if (ParallelDescriptor::IOProcessor()) {
+                print_summary(names, all_longs, all_waits);
+                if (!json_file.empty()) {
+                    write_json(names, all_longs, all_waits);
+                }
+            }
+        }
+    }
+
+    site_index.clear();
+    site_names.clear();
+    site_stats.clear();
+    enabled = false;
+    json_file.clear();
+    initialized = false;
+}
+
+bool
+Enabled () noexcept
+{
+    return enabled;
+}
+
+int
+Record (const char* op, Vector<std::string> const& tags,
+        FabArrayBase::MapOfCopyComTagContainers const& snd_tags,
+        FabArrayBase::MapOfCopyComTagContainers const& rcv_tags,
+        FabArrayBase::CopyComTagsContainer const& loc_tags,
+        Long bytes_per_point, bool count_messages)
+{
+    std::string name(scope_name ? scope_name : op);
+    // The first tag is always "All".
+    if (tags.size() > 1) {
+        name.append(" ").append(tags.back());
+    }
+
+    auto it = site_index.find(name);
+    int isite;
+    if (it == site_index.end()) {
+        isite = static_cast<int>(site_stats.size());
+        site_index.emplace(name, isite);
+        site_names.push_back(name);
+        site_stats.emplace_back();
+    } else {
+        isite = it->second;
+    }
+
+    auto& s = site_stats[isite];
+    ++s.ncalls;
+    for (auto const& kv : snd_tags) {
+        if (kv.first != ParallelDescriptor::MyProc()) {
+            if (count_messages) { ++s.nsend; }
+            s.send_bytes += num_pts(kv.second) * bytes_per_point;
+        }
+    }
+    for (auto const& kv : rcv_tags) {
+        if (kv.first != ParallelDescriptor::MyProc()) {
+            if (count_messages) { ++s.nrecv; }
+            s.recv_bytes += num_pts(kv.second) * bytes_per_point;
+        }
+    }
+    s.local_bytes += num_pts(loc_tags) * bytes_per_point;
+    s.max_neighbors = std::max({s.max_neighbors, Long(snd_tags.size()), Long(rcv_tags.size())});
+
+    return isite;
+}
+
+void
+RecordMessages (int site, Long nsend, Long nrecv) noexcept
+{
+    if (site >= 0) {
+        site_stats[site].nsend += nsend;
+        site_stats[site].nrecv += nrecv;
+    }
+}
+
+WaitTimer::WaitTimer (int site) noexcept
+    : m_site(site)
+{
+    if (m_site >= 0) {
+        m_t0 = amrex::second();
+    }
+}
+
+WaitTimer::~WaitTimer ()
+{
+    if (m_site >= 0) {
+        site_stats[m_site].wait_time += amrex::second() - m_t0;
+    }
+}
+
+Scope::Scope (const char* name) noexcept
+    : m_prev(scope_name)
+{
+    scope_name = name;
+}
+
+Scope::~Scope ()
+{
+    scope_name = m_prev;
+}
+
+}
@@ -22,6 +22,8 @@
 #include <string>
 #include <cstring>
 #include <iomanip>
+#include <functional>
+#include <utility>
 
 namespace {
 int flag_verbose_mapper;
@@ -1920,6 +1922,81 @@ DistributionMapping::makeSFC (const BoxArray& ba, bool use_box_vol, int nprocs)
     return r;
 }
 
+DistributionMapping
+DistributionMapping::makeIncremental (const BoxArray& ba, const BoxArray& old_ba,
+                                      const DistributionMapping& old_dm, Real max_imbalance)
+{
+    BL_PROFILE("makeIncremental");
+
+    const int N = static_cast<int>(ba.size());
+    const int nprocs = ParallelContext::NProcsSub();
+
+    // The ranks in the sub-communicator of the old owners.  Those not in it
+    // become negative.
+    Vector<int> old_pmap(old_dm.size());
+    ParallelContext::global_to_local_rank(old_pmap.data(), old_dm.ProcessorMap().data(),
+                                          static_cast<int>(old_pmap.size()));
+
+    Vector<int> pmap(N, -1);
+    std::vector<Long> load(nprocs, 0);
+    Vector<int> changed;
+    std::vector<std::pair<int,Box>> isects;
+    for (int i = 0; i < N; ++i)
+    {
+        const Box& bx = ba[i];
+        int rank = -1;
+        old_ba.intersections(bx, isects);
+        for (auto const& is : isects) {
+            if (is.second == bx && old_ba[is.first] == bx) {
+                rank = old_pmap[is.first];
+                break;
+            }
+        }
+        if (rank >= 0 && rank < nprocs) {
+            pmap[i] = ParallelContext::local_to_global_rank(rank);
+            load[rank] += bx.numPts();
+        } else {
+            changed.push_back(i);
+        }
+    }
+
+    if (static_cast<int>(changed.size()) == N) {
+        return DistributionMapping{};
+    }
+
+    std::stable_sort(changed.begin(), changed.end(), [&] (int a, int b) {
+        return ba[a].numPts() > ba[b].numPts();
+    });
+
+    using LoadRank = std::pair<Long,int>;
+    std::priority_queue<LoadRank, std::vector<LoadRank>, std::greater<>> pq;
+    for (int rank = 0; rank < nprocs; ++rank) {
+        pq.emplace(load[rank], rank);
+    }
+    for (int i : changed) {
+        auto [l, rank] = pq.top();
+        pq.pop();
+        pmap[i] = ParallelContext::local_to_global_rank(rank);
+        load[rank] = l + ba[i].numPts();
+        pq.emplace(load[rank], rank);
+    }
+
+    if (max_imbalance > Real(0)) {
+        Long total = 0, max_box = 0;
+        for (int i = 0; i < N; ++i) {
+            total += ba[i].numPts();
+            max_box = std::max(max_box, ba[i].numPts());
+        }
+        const Real ideal = std::max(Real(total)/Real(nprocs), Real(max_box));
+        const Long max_load = *std::max_element(load.begin(), load.end());
+        if (Real(max_load) > max_imbalance * ideal) {
+            return DistributionMapping{};
+        }
+    }
+
+    return DistributionMapping(std::move(pmap));
+}
+
 const Vector<int>&
 DistributionMapping::getIndexArray ()
 {
@@ -0,0 +1,312 @@
+#include <AMReX_FBWindow.H>
+#include <AMReX_BLProfiler.H>
+#include <AMReX_GpuControl.H>
+#include <AMReX_ParallelContext.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+
+namespace amrex {
+
+namespace {
+    bool initialized = false;
+    bool use_rma = false;
+    int min_uses = 2;
+
+    // The windows that have been created and not yet freed, by id.  This
+    // is the same on all processes, because windows are created and freed
+    // collectively.
+    int next_id = 0;
+    std::map<int,FBWindow*> active_windows;
+
+    // The windows released on this process, but not yet freed.
+    std::map<int,std::unique_ptr<FBWindow>> released_windows;
+}
+
+void
+FBWindow::Initialize ()
+{
+    if (initialized) { return; }
+    initialized = true;
+
+    ParmParse pp("fabarray");
+    pp.queryAdd("fb_rma", use_rma);
+    pp.queryAdd("fb_rma_min_uses", min_uses);
+    min_uses = std::max(min_uses, 1);
+}
+
+void
+FBWindow::Finalize ()
+{
+    // In the same order on all processes
+    for (auto const& kv : active_windows) {
+        kv.second->free_window();
+    }
+    active_windows.clear();
+    released_windows.clear();
+    next_id = 0;
+    initialized = false;
+}
+
+bool
+FBWindow::Enabled ()
+{
+#ifdef BL_USE_MPI
+    return use_rma && ParallelDescriptor::NProcs() > 1
+        && Gpu::notInLaunchRegion()
+        && ParallelContext::CommunicatorSub() == ParallelDescriptor::Communicator();
+#else
+    return false;
+#endif
+}
+
+FBWindow*
+FBWindow::Find (std::vector<std::unique_ptr<FBWindow>>& windows,
+                FabArrayBase const& fa, FabArrayBase::FB const& fb,
+                std::size_t value_size)
+{
+    auto const& bdkey = fa.getBDKey();
+
+    // The layout has changed.
+    auto it = std::partition(windows.begin(), windows.end(),
+                             [&] (std::unique_ptr<FBWindow> const& w)
+                             { return w->m_bdkey == bdkey; });
+    if (it != windows.end()) {
+        std::vector<std::unique_ptr<FBWindow>> old(std::make_move_iterator(it),
+                                                   std::make_move_iterator(windows.end()));
+        windows.erase(it, windows.end());
+        Release(old);
+    }
+
+    FBWindow* w = nullptr;
+    for (auto const& p : windows) {
+        if (p->match(bdkey, fb, value_size)) {
+            w = p.get();
+            ++(w->m_nuse);
+            break;
+        }
+    }
+
+    if (w == nullptr) {
+        windows.push_back(std::make_unique<FBWindow>(fa, fb, value_size));
+        w = windows.back().get();
+    }
+
+    if (!w->m_active && w->m_nuse >= min_uses) {
+        w->create(fb);
+    }
+
+    return w->m_active ? w : nullptr;
+}
+
+void
+FBWindow::Release (std::vector<std::unique_ptr<FBWindow>>& windows)
+{
+    for (auto& w : windows) {
+        if (w->m_id >= 0) {
+            released_windows[w->m_id] = std::move(w);
+        }
+    }
+    windows.clear();
+}
+
+void
+FBWindow::FreeReleased ()
+{
+#ifdef BL_USE_MPI
+    if (active_windows.empty()) { return; }
+
+    BL_PROFILE("FBWindow::FreeReleased()");
+
+    // A window can be freed if it has been released on all processes.
+    Vector<int> released;
+    released.reserve(active_windows.size());
+    for (auto const& kv : active_windows) {
+        released.push_back(static_cast<int>(released_windows.count(kv.first)));
+    }
+    ParallelDescriptor::ReduceIntMin(released.data(), static_cast<int>(released.size()));
+
+    int i = 0;
+    for (auto it = active_windows.begin(); it != active_windows.end(); ++i) {
+        if (released[i]) {
+            it->second->free_window();
+            released_windows.erase(it->first);
+            it = active_windows.erase(it);
+        } else {
+            ++it;
+        }
+    }
+#endif
+}
+
+FBWindow::FBWindow (FabArrayBase const& fa, FabArrayBase::FB const& fb, std::size_t value_size)
+    : m_nuse(1),
+      m_bdkey(fa.getBDKey()),
+      m_ngrow(fb.m_ngrow),
+      m_cross(fb.m_cross),
+      m_epo(fb.m_epo),
+      m_override_sync(fb.m_override_sync),
+      m_period(fb.m_period),
+      m_value_size(value_size),
+      m_ncomp_max(fa.nComp())
+{}
+
+FBWindow::~FBWindow ()
+{
+    // The window has been freed collectively or has never been created.
+    AMREX_ASSERT(m_id < 0);
+#ifdef BL_USE_MPI
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (finalized) { return; }
+    if (m_send_group != MPI_GROUP_NULL) {
+        MPI_Group_free(&m_send_group);
+    }
+    if (m_recv_group != MPI_GROUP_NULL) {
+        MPI_Group_free(&m_recv_group);
+    }
+#endif
+}
+
+bool
+FBWindow::match (FabArrayBase::BDKey const& bdkey, FabArrayBase::FB const& fb,
+                 std::size_t value_size) const noexcept
+{
+    return m_bdkey         == bdkey
+        && m_ngrow         == fb.m_ngrow
+        && m_cross         == fb.m_cross
+        && m_epo           == fb.m_epo
+        && m_override_sync == fb.m_override_sync
+        && m_period        == fb.m_period
+        && m_value_size    == value_size;
+}
+
+void
+FBWindow::create (FabArrayBase::FB const& fb)
+{
+    amrex::ignore_unused(fb);
+#ifdef BL_USE_MPI
+    BL_PROFILE("FBWindow::create()");
+
+    // This is a collective point.
+    FreeReleased();
+
+    MPI_Comm comm = ParallelDescriptor::Communicator();
+    const int SeqNum = ParallelDescriptor::SeqNum();
+
+    Vector<int> recv_from;
+    Long npts_tot = 0;
+    for (auto const& kv : *fb.m_RcvTags) {
+        Long npts = 0;
+        for (auto const& cct : kv.second) {
+            npts += cct.dbox.numPts();
+        }
+        recv_from.push_back(kv.first);
+        m_recv_offset.push_back(npts_tot);
+        m_recv_npts.push_back(npts);
+        npts_tot += npts;
+    }
+
+    for (auto const& kv : *fb.m_SndTags) {
+        m_send_rank.push_back(kv.first);
+    }
+
+    const auto nrecv = static_cast<int>(recv_from.size());
+    const auto nsend = static_cast<int>(m_send_rank.size());
+
+    // Tell the senders where to put their data.
+    m_target_offset.resize(nsend);
+    Vector<MPI_Request> reqs(nrecv+nsend);
+    for (int i = 0; i < nsend; ++i) {
+        BL_MPI_REQUIRE( MPI_Irecv(&m_target_offset[i], 1, ParallelDescriptor::Mpi_typemap<Long>::type(),
+                                  m_send_rank[i], SeqNum, comm, &reqs[i]) );
+    }
+    for (int i = 0; i < nrecv; ++i) {
+        BL_MPI_REQUIRE( MPI_Isend(&m_recv_offset[i], 1, ParallelDescriptor::Mpi_typemap<Long>::type(),
+                                  recv_from[i], SeqNum, comm, &reqs[nsend+i]) );
+    }
+    if (!reqs.empty()) {
+        BL_MPI_REQUIRE( MPI_Waitall(static_cast<int>(reqs.size()), reqs.data(), MPI_STATUSES_IGNORE) );
+    }
+
+    MPI_Group world_group;
+    BL_MPI_REQUIRE( MPI_Comm_group(comm, &world_group) );
+    BL_MPI_REQUIRE( MPI_Group_incl(world_group, nsend, m_send_rank.data(), &m_send_group) );
+    BL_MPI_REQUIRE( MPI_Group_incl(world_group, nrecv, recv_from.data(), &m_recv_group) );
+    MPI_Group_free(&world_group);
+
+    auto nbytes = static_cast<MPI_Aint>(npts_tot * m_ncomp_max * m_value_size);
+    BL_MPI_REQUIRE( MPI_Win_allocate(nbytes, 1, MPI_INFO_NULL, comm, &m_base, &m_win) );
+
+    m_active = true;
+    m_id = next_id++;
+    active_windows[m_id] = this;
+#endif
+}
+
+void
+FBWindow::free_window ()
+{
+#ifdef BL_USE_MPI
+    if (m_win != MPI_WIN_NULL) {
+        MPI_Win_free(&m_win);
+    }
+    m_base = nullptr;
+#endif
+    m_active = false;
+    m_id = -1;
+}
+
+void
+FBWindow::Start ()
+{
+#ifdef BL_USE_MPI
+    BL_PROFILE("FBWindow::Start()");
+    BL_MPI_REQUIRE( MPI_Win_post(m_recv_group, 0, m_win) );
+    BL_MPI_REQUIRE( MPI_Win_start(m_send_group, 0, m_win) );
+#endif
+}
+
+void
+FBWindow::Put (Vector<char*> const& send_data, Vector<std::size_t> const& send_size, int ncomp)
+{
+    amrex::ignore_unused(send_data, send_size, ncomp);
+#ifdef BL_USE_MPI
+    BL_PROFILE("FBWindow::Put()");
+    AMREX_ASSERT(ncomp <= m_ncomp_max);
+    AMREX_ASSERT(send_data.size() == m_send_rank.size());
+
+    const auto nsend = static_cast<int>(m_send_rank.size());
+    for (int i = 0; i < nsend; ++i) {
+        AMREX_ALWAYS_ASSERT(send_size[i] <= static_cast<std::size_t>(std::numeric_limits<int>::max()));
+        const auto n = static_cast<int>(send_size[i]);
+        auto disp = static_cast<MPI_Aint>(m_target_offset[i] * ncomp * m_value_size);
+        BL_MPI_REQUIRE( MPI_Put(send_data[i], n, MPI_BYTE, m_send_rank[i],
+                                disp, n, MPI_BYTE, m_win) );
+    }
+#endif
+}
+
+void
+FBWindow::Wait (Vector<char*>& recv_data, Vector<std::size_t>& recv_size, int ncomp)
+{
+    amrex::ignore_unused(recv_data, recv_size, ncomp);
+#ifdef BL_USE_MPI
+    BL_PROFILE("FBWindow::Wait()");
+    BL_MPI_REQUIRE( MPI_Win_complete(m_win) );
+    BL_MPI_REQUIRE( MPI_Win_wait(m_win) );
+
+    const auto nrecv = static_cast<int>(m_recv_offset.size());
+    recv_data.resize(nrecv);
+    recv_size.resize(nrecv);
+    for (int i = 0; i < nrecv; ++i) {
+        recv_data[i] = m_base + m_recv_offset[i] * ncomp * m_value_size;
+        recv_size[i] = m_recv_npts[i] * ncomp * m_value_size;
+    }
+#endif
+}
+
+}
@@ -5,6 +5,11 @@
 #include <AMReX_Geometry.H>
 #include <AMReX_FArrayBox.H>
 #include <AMReX_NonLocalBC.H>
+#include <AMReX_NodeExchange.H>
+#include <AMReX_FBWindow.H>
+#include <AMReX_CommReport.H>
+#include <AMReX_TileTuner.H>
+#include <AMReX_Morton.H>
 
 #include <AMReX_BArena.H>
 #include <AMReX_CArena.H>
@@ -17,12 +22,18 @@
 #include <AMReX_MemProfiler.H>
 #endif
 
+#ifdef AMREX_TINY_PROFILING
+#include <AMReX_TinyProfiler.H>
+#endif
+
 #ifdef AMREX_USE_EB
 #include <AMReX_EB2.H>
 #include <AMReX_EBFabFactory.H>
 #endif
 
 #include <algorithm>
+#include <cstdint>
+#include <numeric>
 #include <utility>
 
 namespace amrex {
@@ -58,8 +69,13 @@ IntVect FabArrayBase::comm_tile_size(AMREX_D_DECL(1024000, 8, 8));
 #endif
 
 FabArrayBase::TACache              FabArrayBase::m_TheTileArrayCache;
+FabArrayBase::TASplitCache         FabArrayBase::m_TheSplitTileArrayCache;
 FabArrayBase::FBCache              FabArrayBase::m_TheFBCache;
+FabArrayBase::FBHash               FabArrayBase::m_TheFBHash;
+FabArrayBase::FBLRU                FabArrayBase::m_TheFBLRU;
 FabArrayBase::CPCache              FabArrayBase::m_TheCPCache;
+FabArrayBase::CPCHash              FabArrayBase::m_TheCPCHash;
+FabArrayBase::CPCLRU               FabArrayBase::m_TheCPCLRU;
 FabArrayBase::RB90Cache            FabArrayBase::m_TheRB90Cache;
 FabArrayBase::RB180Cache           FabArrayBase::m_TheRB180Cache;
 FabArrayBase::PolarBCache          FabArrayBase::m_ThePolarBCache;
@@ -76,6 +92,10 @@ FabArrayBase::CacheStats           FabArrayBase::m_CPC_stats("CopyCache");
 FabArrayBase::CacheStats           FabArrayBase::m_FPinfo_stats("FillPatchCache");
 FabArrayBase::CacheStats           FabArrayBase::m_CFinfo_stats("CrseFineCache");
 
+Long                               FabArrayBase::m_FBC_max_bytes = -1;
+Long                               FabArrayBase::m_CPC_max_bytes = -1;
+int                                FabArrayBase::m_comm_cache_min_entries = 16;
+
 std::map<FabArrayBase::BDKey, int> FabArrayBase::m_BD_count;
 
 FabArrayBase::FabArrayStats        FabArrayBase::m_FA_stats;
@@ -88,6 +108,163 @@ bool                               FabArrayBase::m_alloc_single_chunk = false;
 namespace
 {
     bool initialized = false;
+
+    // The indices of the tiles sorted along a Morton curve through their
+    // small ends, measured in units of the smallest tile.
+    Vector<int> morton_order (Vector<Box> const& tiles)
+    {
+        const auto ntiles = static_cast<int>(tiles.size());
+        Vector<int> order(ntiles);
+        std::iota(order.begin(), order.end(), 0);
+        if (ntiles <= 1) { return order; }
+
+        IntVect lo = tiles[0].smallEnd();
+        IntVect len = tiles[0].length();
+        for (auto const& t : tiles) {
+            lo.min(t.smallEnd());
+            len.min(t.length());
+        }
+
+        Vector<IntVect> pos(ntiles);
+        int posmax = 0;
+        for (int i = 0; i < ntiles; ++i) {
+            pos[i] = (tiles[i].smallEnd() - lo) / len;
+            posmax = std::max(posmax, pos[i].max());
+        }
+
+#if (AMREX_SPACEDIM == 3)
+        constexpr int nbits = 10;
+#elif (AMREX_SPACEDIM == 2)
+        constexpr int nbits = 16;
+#else
+        constexpr int nbits = 31;
+#endif
+        int shift = 0;
+        while ((posmax >> shift) >= (1 << nbits)) { ++shift; }
+
+        Vector<std::uint32_t> code(ntiles);
+        for (int i = 0; i < ntiles; ++i) {
+            code[i] = AMREX_D_TERM(  Morton::makeSpace(std::uint32_t(pos[i][0] >> shift)),
+                                   | (Morton::makeSpace(std::uint32_t(pos[i][1] >> shift)) << 1),
+                                   | (Morton::makeSpace(std::uint32_t(pos[i][2] >> shift)) << 2));
+        }
+        std::stable_sort(order.begin(), order.end(),
+                         [&] (int i, int j) { return code[i] < code[j]; });
+        return order;
+    }
+
+    std::size_t period_hash (const Periodicity& period) noexcept
+    {
+        std::size_t h = 0;
+        for (int i = 0; i < AMREX_SPACEDIM; ++i) {
+            if (period.isPeriodic(i)) { h |= std::size_t(1) << i; }
+        }
+        return h;
+    }
+
+    std::size_t fb_hash (const FabArrayBase::BDKey& bdkey, const BoxArray& ba,
+                         const IntVect& nghost, bool cross, bool multi_ghost,
+                         bool epo, bool override_sync, const Periodicity& period) noexcept
+    {
+        uint64_t h = bdkey.hash();
+        hash_combine(h, IntVect::shift_hasher{}(ba.ixType().ixType()));
+        hash_combine(h, IntVect::shift_hasher{}(ba.crseRatio()));
+        hash_combine(h, IntVect::shift_hasher{}(nghost));
+        hash_combine(h, period_hash(period));
+        hash_combine(h, int(cross) | (int(multi_ghost) << 1) | (int(epo) << 2)
+                                   | (int(override_sync) << 3));
+        return static_cast<std::size_t>(h);
+    }
+
+    std::size_t cpc_hash (const FabArrayBase::BDKey& dstkey, const IntVect& dstng,
+                          const FabArrayBase::BDKey& srckey, const IntVect& srcng,
+                          const Periodicity& period, bool tgco) noexcept
+    {
+        uint64_t h = dstkey.hash();
+        hash_combine(h, srckey.hash());
+        hash_combine(h, IntVect::shift_hasher{}(dstng));
+        hash_combine(h, IntVect::shift_hasher{}(srcng));
+        hash_combine(h, period_hash(period));
+        hash_combine(h, tgco);
+        return static_cast<std::size_t>(h);
+    }
+
+    // Remove a cached item from the hash index and the LRU list.
+    template <class T, class H, class L>
+    void eraseFromIndex (T* p, H& hash_index, L& lru)
+    {
+        auto er_it = hash_index.equal_range(p->m_hash);
+        for (auto it = er_it.first; it != er_it.second; ++it) {
+            if (it->second == p) {
+                hash_index.erase(it);
+                break;
+            }
+        }
+        lru.erase(p->m_lru);
+    }
+
+    // Remove a cached item from the BDKey map.
+    template <class T, class M>
+    void eraseFromMap (T* p, const FabArrayBase::BDKey& key, M& m)
+    {
+        auto er_it = m.equal_range(key);
+        for (auto it = er_it.first; it != er_it.second; ++it) {
+            if (it->second == p) {
+                m.erase(it);
+                break;
+            }
+        }
+    }
+
+    //
+    // Chop a cell-centered box into tiles.
+    // This must be consistent with ParticleContainer::getTileIndex function!!!
+    //
+    void tileBox (const Box& bx, const IntVect& tileSize, Vector<Box>& tiles)
+    {
+        if (tileSize == IntVect::TheZeroVector()) {
+            tiles.push_back(bx);
+            return;
+        }
+
+        IntVect nt_in_fab, tsize, nleft;
+        int ntiles = 1;
+        for (int d=0; d<AMREX_SPACEDIM; d++) {
+            int ncells = bx.length(d);
+            nt_in_fab[d] = std::max(ncells/tileSize[d], 1);
+            tsize    [d] = ncells/nt_in_fab[d];
+            nleft    [d] = ncells - nt_in_fab[d]*tsize[d];
+            ntiles *= nt_in_fab[d];
+        }
+
+        IntVect small, big, ijk;  // note that the initial values are all zero.
+        ijk[0] = -1;
+        for (int t = 0; t < ntiles; ++t) {
+            for (int d=0; d<AMREX_SPACEDIM; d++) {
+                if (ijk[d]<nt_in_fab[d]-1) {
+                    ijk[d]++;
+                    break;
+                } else {
+                    ijk[d] = 0;
+                }
+            }
+
+            for (int d=0; d<AMREX_SPACEDIM; d++) {
+                if (ijk[d] < nleft[d]) {
+                    small[d] = ijk[d]*(tsize[d]+1);
+                    big[d] = small[d] + tsize[d];
+                } else {
+                    small[d] = ijk[d]*tsize[d] + nleft[d];
+                    big[d] = small[d] + tsize[d] - 1;
+                }
+            }
+
+            Box tbx(small, big, IndexType::TheCellType());
+            tbx.shift(bx.smallEnd());
+
+            tiles.push_back(tbx);
+        }
+    }
 }
 
 void
@@ -124,6 +301,13 @@ FabArrayBase::Initialize ()
 
     pp.query("maxcomp", FabArrayBase::MaxComp);
 
+    pp.queryAdd("fb_cache_max_bytes", FabArrayBase::m_FBC_max_bytes);
+    pp.queryAdd("cpc_cache_max_bytes", FabArrayBase::m_CPC_max_bytes);
+    pp.queryAdd("comm_cache_min_entries", FabArrayBase::m_comm_cache_min_entries);
+    // A caller may hold a reference to the last entry while it gets a new
+    // one (e.g., YAFluxRegister), so at least two entries are kept.
+    m_comm_cache_min_entries = std::max(m_comm_cache_min_entries, 2);
+
     if (MaxComp < 1) {
         MaxComp = 1;
     }
@@ -131,8 +315,27 @@ FabArrayBase::Initialize ()
     ParmParse ppmf("amrex.mf");
     ppmf.queryAdd("alloc_single_chunk", FabArrayBase::m_alloc_single_chunk);
 
+    NodeExchange::Initialize();
+    FBWindow::Initialize();
+    CommReport::Initialize();
+    TileTuner::Initialize();
+
     amrex::ExecOnFinalize(FabArrayBase::Finalize);
 
+#ifdef AMREX_TINY_PROFILING
+    for (auto* stats : {&m_FBC_stats, &m_CPC_stats}) {
+        TinyProfiler::RegisterCounters(stats->name, [stats] () -> TinyProfiler::CounterList {
+            return {{"hits",          stats->nuse - stats->nbuild},
+                    {"misses",        stats->nbuild},
+                    {"evictions",     stats->nevict},
+                    {"entries",       stats->size},
+                    {"max entries",   stats->maxsize},
+                    {"bytes",         stats->bytes},
+                    {"max bytes",     stats->bytes_hwm}};
+        });
+    }
+#endif
+
 #ifdef AMREX_MEM_PROFILING
     MemProfiler::add(m_TAC_stats.name, std::function<MemProfiler::MemInfo()>
                      ([] () -> MemProfiler::MemInfo {
@@ -281,7 +484,8 @@ FabArrayBase::TileArray::bytes () const
         + (amrex::bytesOf(this->indexMap)          - sizeof(this->indexMap))
         + (amrex::bytesOf(this->localIndexMap)     - sizeof(this->localIndexMap))
         + (amrex::bytesOf(this->localTileIndexMap) - sizeof(this->localTileIndexMap))
-        + (amrex::bytesOf(this->tileArray)         - sizeof(this->tileArray));
+        + (amrex::bytesOf(this->tileArray)         - sizeof(this->tileArray))
+        + (amrex::bytesOf(this->mortonOrder)       - sizeof(this->mortonOrder));
 }
 
 //
@@ -536,10 +740,9 @@ FabArrayBase::flushCPC (bool no_assertion) const
             }
         }
 
-#ifdef AMREX_MEM_PROFILING
-        m_CPC_stats.bytes -= it->second->bytes();
-#endif
+        m_CPC_stats.bytes -= it->second->m_bytes;
         m_CPC_stats.recordErase(it->second->m_nuse);
+        eraseFromIndex(it->second, m_TheCPCHash, m_TheCPCLRU);
         delete it->second;
     }
 
@@ -565,9 +768,39 @@ FabArrayBase::flushCPCache ()
         delete c;
     }
     m_TheCPCache.clear();
-#ifdef AMREX_MEM_PROFILING
+    m_TheCPCHash.clear();
+    m_TheCPCLRU.clear();
     m_CPC_stats.bytes = 0L;
-#endif
+}
+
+void
+FabArrayBase::trimCPCache ()
+{
+    if (m_CPC_max_bytes < 0) { return; }
+
+    // Walk from the least recently used end.  The most recently used
+    // m_comm_cache_min_entries entries and the ones used by pending
+    // communications are kept.
+    auto n = static_cast<int>(m_TheCPCLRU.size());
+    auto it = m_TheCPCLRU.end();
+    while (m_CPC_stats.bytes > m_CPC_max_bytes && n > m_comm_cache_min_entries)
+    {
+        --it;
+        --n;
+        CPC* cpc = *it;
+        if (cpc->m_npin > 0) { continue; }
+
+        eraseFromMap(cpc, cpc->m_dstbdk, m_TheCPCache);
+        if (cpc->m_srcbdk != cpc->m_dstbdk) {
+            eraseFromMap(cpc, cpc->m_srcbdk, m_TheCPCache);
+        }
+        ++it; // because the current position is about to be erased
+        eraseFromIndex(cpc, m_TheCPCHash, m_TheCPCLRU);
+
+        m_CPC_stats.bytes -= cpc->m_bytes;
+        m_CPC_stats.recordEvict(cpc->m_nuse);
+        delete cpc;
+    }
 }
 
 const FabArrayBase::CPC&
@@ -583,7 +816,9 @@ FabArrayBase::getCPC (const IntVect& dstng, const FabArrayBase& src, const IntVe
     const BDKey& srckey = src.getBDKey();
     const BDKey& dstkey =     getBDKey();
 
-    std::pair<CPCacheIter,CPCacheIter> er_it = m_TheCPCache.equal_range(dstkey);
+    const std::size_t h = cpc_hash(dstkey, dstng, srckey, srcng, period, to_ghost_cells_only);
+
+    auto er_it = m_TheCPCHash.equal_range(h);
 
     for (auto it = er_it.first; it != er_it.second; ++it)
     {
@@ -598,6 +833,7 @@ FabArrayBase::getCPC (const IntVect& dstng, const FabArrayBase& src, const IntVe
         {
             ++(it->second->m_nuse);
             m_CPC_stats.recordUse();
+            m_TheCPCLRU.splice(m_TheCPCLRU.begin(), m_TheCPCLRU, it->second->m_lru);
             return *(it->second);
         }
     }
@@ -605,19 +841,24 @@ FabArrayBase::getCPC (const IntVect& dstng, const FabArrayBase& src, const IntVe
     // Have to build a new one
     CPC* new_cpc = new CPC(*this, dstng, src, srcng, period, to_ghost_cells_only);
 
-#ifdef AMREX_MEM_PROFILING
-    m_CPC_stats.bytes += new_cpc->bytes();
+    new_cpc->m_hash = h;
+    new_cpc->m_bytes = new_cpc->bytes();
+    m_CPC_stats.bytes += new_cpc->m_bytes;
     m_CPC_stats.bytes_hwm = std::max(m_CPC_stats.bytes_hwm, m_CPC_stats.bytes);
-#endif
 
     new_cpc->m_nuse = 1;
     m_CPC_stats.recordBuild();
     m_CPC_stats.recordUse();
 
-    m_TheCPCache.insert(er_it.second, CPCache::value_type(dstkey,new_cpc));
+    m_TheCPCache.insert(CPCache::value_type(dstkey,new_cpc));
     if (srckey != dstkey) {
-        m_TheCPCache.insert(          CPCache::value_type(srckey,new_cpc));
+        m_TheCPCache.insert(CPCache::value_type(srckey,new_cpc));
     }
+    m_TheCPCHash.insert(CPCHash::value_type(h,new_cpc));
+    m_TheCPCLRU.push_front(new_cpc);
+    new_cpc->m_lru = m_TheCPCLRU.begin();
+
+    trimCPCache();
 
     return *new_cpc;
 }
@@ -1187,10 +1428,9 @@ FabArrayBase::flushFB (bool no_assertion) const
     std::pair<FBCacheIter,FBCacheIter> er_it = m_TheFBCache.equal_range(m_bdkey);
     for (auto it = er_it.first; it != er_it.second; ++it)
     {
-#ifdef AMREX_MEM_PROFILING
-        m_FBC_stats.bytes -= it->second->bytes();
-#endif
+        m_FBC_stats.bytes -= it->second->m_bytes;
         m_FBC_stats.recordErase(it->second->m_nuse);
+        eraseFromIndex(it->second, m_TheFBHash, m_TheFBLRU);
         delete it->second;
     }
     m_TheFBCache.erase(er_it.first, er_it.second);
@@ -1205,9 +1445,36 @@ FabArrayBase::flushFBCache ()
         delete it.second;
     }
     m_TheFBCache.clear();
-#ifdef AMREX_MEM_PROFILING
+    m_TheFBHash.clear();
+    m_TheFBLRU.clear();
     m_FBC_stats.bytes = 0L;
-#endif
+}
+
+void
+FabArrayBase::trimFBCache ()
+{
+    if (m_FBC_max_bytes < 0) { return; }
+
+    // Walk from the least recently used end.  The most recently used
+    // m_comm_cache_min_entries entries and the ones used by pending
+    // communications are kept.
+    auto n = static_cast<int>(m_TheFBLRU.size());
+    auto it = m_TheFBLRU.end();
+    while (m_FBC_stats.bytes > m_FBC_max_bytes && n > m_comm_cache_min_entries)
+    {
+        --it;
+        --n;
+        FB* fb = *it;
+        if (fb->m_npin > 0) { continue; }
+
+        eraseFromMap(fb, fb->m_bdkey, m_TheFBCache);
+        ++it; // because the current position is about to be erased
+        eraseFromIndex(fb, m_TheFBHash, m_TheFBLRU);
+
+        m_FBC_stats.bytes -= fb->m_bytes;
+        m_FBC_stats.recordEvict(fb->m_nuse);
+        delete fb;
+    }
 }
 
 const FabArrayBase::FB&
@@ -1218,10 +1485,13 @@ FabArrayBase::getFB (const IntVect& nghost, const Periodicity& period,
     BL_PROFILE("FabArrayBase::getFB()");
 
     BL_ASSERT(getBDKey() == m_bdkey);
-    std::pair<FBCacheIter,FBCacheIter> er_it = m_TheFBCache.equal_range(m_bdkey);
+    const std::size_t h = fb_hash(m_bdkey, boxArray(), nghost, cross, m_multi_ghost,
+                                  enforce_periodicity_only, override_sync, period);
+    auto er_it = m_TheFBHash.equal_range(h);
     for (auto it = er_it.first; it != er_it.second; ++it)
     {
-        if (it->second->m_typ        == boxArray().ixType()      &&
+        if (it->second->m_bdkey      == m_bdkey                  &&
+            it->second->m_typ        == boxArray().ixType()      &&
             it->second->m_crse_ratio == boxArray().crseRatio()   &&
             it->second->m_ngrow      == nghost                   &&
             it->second->m_cross      == cross                    &&
@@ -1232,6 +1502,7 @@ FabArrayBase::getFB (const IntVect& nghost, const Periodicity& period,
         {
             ++(it->second->m_nuse);
             m_FBC_stats.recordUse();
+            m_TheFBLRU.splice(m_TheFBLRU.begin(), m_TheFBLRU, it->second->m_lru);
             return *(it->second);
         }
     }
@@ -1240,16 +1511,22 @@ FabArrayBase::getFB (const IntVect& nghost, const Periodicity& period,
     FB* new_fb = new FB(*this, nghost, cross, period, enforce_periodicity_only,
                         override_sync, m_multi_ghost);
 
-#ifdef AMREX_MEM_PROFILING
-    m_FBC_stats.bytes += new_fb->bytes();
+    new_fb->m_bdkey = m_bdkey;
+    new_fb->m_hash = h;
+    new_fb->m_bytes = new_fb->bytes();
+    m_FBC_stats.bytes += new_fb->m_bytes;
     m_FBC_stats.bytes_hwm = std::max(m_FBC_stats.bytes_hwm, m_FBC_stats.bytes);
-#endif
 
     new_fb->m_nuse = 1;
     m_FBC_stats.recordBuild();
     m_FBC_stats.recordUse();
 
-    m_TheFBCache.insert(er_it.second, FBCache::value_type(m_bdkey,new_fb));
+    m_TheFBCache.insert(FBCache::value_type(m_bdkey,new_fb));
+    m_TheFBHash.insert(FBHash::value_type(h,new_fb));
+    m_TheFBLRU.push_front(new_fb);
+    new_fb->m_lru = m_TheFBLRU.begin();
+
+    trimFBCache();
 
     return *new_fb;
 }
@@ -2219,6 +2496,11 @@ FabArrayBase::Finalize ()
     FabArrayBase::flushParForCache();
 #endif
 
+    NodeExchange::Finalize();
+    FBWindow::Finalize();
+    CommReport::Finalize();
+    TileTuner::Finalize();
+
     if (ParallelDescriptor::IOProcessor() && amrex::system::verbose > 1) {
         m_FA_stats.print();
         m_TAC_stats.print();
@@ -2269,9 +2551,42 @@ FabArrayBase::getTileArray (const IntVect& tilesize) const
                                              m_TAC_stats.bytes);
 #endif
         }
+        // Not omp master, which every pool thread would pass.
+        if (OpenMP::get_thread_num() == 0)
+        {
+            ++(p->nuse);
+            m_TAC_stats.recordUse();
+        }
+    }
+
+    return p;
+}
+
+const FabArrayBase::TileArray*
+FabArrayBase::getSplitTileArray (const IntVect& tilesize, const IntVect& nghost) const
+{
+    TileArray* p;
+
 #ifdef AMREX_USE_OMP
-#pragma omp master
+#pragma omp critical(gettilearray)
 #endif
+    {
+        BL_ASSERT(getBDKey() == m_bdkey);
+
+        const IntVect& crse_ratio = boxArray().crseRatio();
+        p = &FabArrayBase::m_TheSplitTileArrayCache[m_bdkey][std::make_tuple(tilesize,crse_ratio,nghost)];
+        if (p->nuse == -1) {
+            buildSplitTileArray(tilesize, nghost, *p);
+            p->nuse = 0;
+            m_TAC_stats.recordBuild();
+#ifdef AMREX_MEM_PROFILING
+            m_TAC_stats.bytes += p->bytes();
+            m_TAC_stats.bytes_hwm = std::max(m_TAC_stats.bytes_hwm,
+                                             m_TAC_stats.bytes);
+#endif
+        }
+        // Not omp master, which every pool thread would pass.
+        if (OpenMP::get_thread_num() == 0)
         {
             ++(p->nuse);
             m_TAC_stats.recordUse();
@@ -2323,53 +2638,76 @@ FabArrayBase::buildTileArray (const IntVect& tileSize, TileArray& ta) const
             const int K = indexArray[i]; // global index
             const Box& bx = boxarray.getCellCenteredBox(K);
 
-            //
-            //  This must be consistent with ParticleContainer::getTileIndex function!!!
-            //
-
-            IntVect nt_in_fab, tsize, nleft;
-            int ntiles = 1;
-            for (int d=0; d<AMREX_SPACEDIM; d++) {
-                int ncells = bx.length(d);
-                nt_in_fab[d] = std::max(ncells/tileSize[d], 1);
-                tsize    [d] = ncells/nt_in_fab[d];
-                nleft    [d] = ncells - nt_in_fab[d]*tsize[d];
-                ntiles *= nt_in_fab[d];
-            }
+            Vector<Box> tiles;
+            tileBox(bx, tileSize, tiles);
 
-            IntVect small, big, ijk;  // note that the initial values are all zero.
-            ijk[0] = -1;
+            const auto ntiles = static_cast<int>(tiles.size());
             for (int t = 0; t < ntiles; ++t) {
                 ta.indexMap.push_back(K);
                 ta.localIndexMap.push_back(i);
                 ta.localTileIndexMap.push_back(t);
                 ta.numLocalTiles.push_back(ntiles);
+                ta.tileArray.push_back(tiles[t]);
+            }
+        }
+    }
 
-                for (int d=0; d<AMREX_SPACEDIM; d++) {
-                    if (ijk[d]<nt_in_fab[d]-1) {
-                        ijk[d]++;
-                        break;
-                    } else {
-                        ijk[d] = 0;
-                    }
-                }
+    ta.mortonOrder = morton_order(ta.tileArray);
+}
 
-                for (int d=0; d<AMREX_SPACEDIM; d++) {
-                    if (ijk[d] < nleft[d]) {
-                        small[d] = ijk[d]*(tsize[d]+1);
-                        big[d] = small[d] + tsize[d];
-                    } else {
-                        small[d] = ijk[d]*tsize[d] + nleft[d];
-                        big[d] = small[d] + tsize[d] - 1;
-                    }
-                }
+void
+FabArrayBase::buildSplitTileArray (const IntVect& tileSize, const IntVect& nghost,
+                                   TileArray& ta) const
+{
+    const int N = static_cast<int>(indexArray.size());
+
+    // Tiles of the interior and the shell of each local box
+    Vector<Vector<Box>> interior_tiles(N);
+    Vector<Vector<Box>> shell_tiles(N);
+
+    for (int i = 0; i < N; ++i)
+    {
+        if (!isOwner(i)) { continue; }
+
+        const Box& bx = boxarray.getCellCenteredBox(indexArray[i]);
+        const Box& ibx = amrex::grow(bx, -nghost);
+
+        BoxList shell;
+        if (ibx.ok()) {
+            tileBox(ibx, tileSize, interior_tiles[i]);
+            shell = amrex::boxDiff(bx, ibx);
+        } else {
+            shell.push_back(bx);
+        }
+
+        for (auto const& sbx : shell) {
+            tileBox(sbx, tileSize, shell_tiles[i]);
+        }
+    }
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (int i = 0; i < N; ++i)
+        {
+            if (!isOwner(i)) { continue; }
 
-                Box tbx(small, big, IndexType::TheCellType());
-                tbx.shift(bx.smallEnd());
+            const auto nitiles = static_cast<int>(interior_tiles[i].size());
+            const int ntiles = nitiles + static_cast<int>(shell_tiles[i].size());
+            auto const& tiles = (pass == 0) ? interior_tiles[i] : shell_tiles[i];
+            const int toffset = (pass == 0) ? 0 : nitiles;
 
-                ta.tileArray.push_back(tbx);
+            for (int t = 0; t < static_cast<int>(tiles.size()); ++t) {
+                ta.indexMap.push_back(indexArray[i]);
+                ta.localIndexMap.push_back(i);
+                ta.localTileIndexMap.push_back(t+toffset);
+                ta.numLocalTiles.push_back(ntiles);
+                ta.tileArray.push_back(tiles[t]);
             }
         }
+
+        if (pass == 0) {
+            ta.numInteriorTiles = static_cast<int>(ta.tileArray.size());
+        }
     }
 }
 
@@ -2408,6 +2746,27 @@ FabArrayBase::flushTileArray (const IntVect& tileSize, bool no_assertion) const
             }
         }
     }
+
+    auto tas_it = m_TheSplitTileArrayCache.find(m_bdkey);
+    if (tas_it != m_TheSplitTileArrayCache.end())
+    {
+        TASplitMap& tai = tas_it->second;
+        for (auto tai_it = tai.begin(); tai_it != tai.end(); )
+        {
+            if (tileSize == IntVect::TheZeroVector() || tileSize == std::get<0>(tai_it->first)) {
+#ifdef AMREX_MEM_PROFILING
+                m_TAC_stats.bytes -= tai_it->second.bytes();
+#endif
+                m_TAC_stats.recordErase(tai_it->second.nuse);
+                tai_it = tai.erase(tai_it);
+            } else {
+                ++tai_it;
+            }
+        }
+        if (tai.empty()) {
+            m_TheSplitTileArrayCache.erase(tas_it);
+        }
+    }
 }
 
 void
@@ -2419,6 +2778,12 @@ FabArrayBase::flushTileArrayCache ()
         }
     }
     m_TheTileArrayCache.clear();
+    for (auto const& tao_it : m_TheSplitTileArrayCache) {
+        for (auto const& tai_it : tao_it.second) {
+            m_TAC_stats.recordErase(tai_it.second.nuse);
+        }
+    }
+    m_TheSplitTileArrayCache.clear();
 #ifdef AMREX_MEM_PROFILING
     m_TAC_stats.bytes = 0L;
 #endif
@@ -3,13 +3,141 @@
 #include <AMReX_FabArray.H>
 #include <AMReX_FArrayBox.H>
 #include <AMReX_OpenMP.H>
+#include <AMReX_ThreadPool.H>
+#include <AMReX_TileTuner.H>
+
+#include <atomic>
+#include <memory>
 
 namespace amrex {
 
-int MFIter::nextDynamicIndex = std::numeric_limits<int>::min();
+#ifdef AMREX_USE_OMP
+namespace {
+
+/**
+* The tiles of the current dynamic MFIter.  Each thread owns a contiguous
+* range of the tiles in Morton order.  It takes tiles from the front of its
+* range, and threads without work steal the back half of the range of
+* another thread.  A range is packed into one 64-bit word, so that both
+* ends are updated by a single compare-and-swap.
+*/
+class DynamicQueues
+{
+public:
+
+    void setup (Vector<int> const& order, int ibegin, int iend, int nthreads)
+    {
+        m_tiles.clear();
+        for (int i : order) {
+            if (i >= ibegin && i < iend) { m_tiles.push_back(i); }
+        }
+
+        if (nthreads > m_nranges) {
+            m_ranges = std::make_unique<Range[]>(nthreads);
+        }
+        m_nranges = nthreads;
+
+        const auto ntot = static_cast<std::uint32_t>(m_tiles.size());
+        const auto n = static_cast<std::uint32_t>(nthreads);
+        for (std::uint32_t t = 0; t < n; ++t) {
+            m_ranges[t].be.store(pack(ntot*t/n, ntot*(t+1)/n), std::memory_order_relaxed);
+        }
+    }
+
+    //! Return a tile for thread tid, or -1 if all the tiles have been taken.
+    int pop (int tid, std::uint32_t& seed) noexcept
+    {
+        auto& mine = m_ranges[tid].be;
+        auto v = mine.load(std::memory_order_acquire);
+        while (begin(v) < end(v)) {
+            if (mine.compare_exchange_weak(v, pack(begin(v)+1, end(v)),
+                                           std::memory_order_acq_rel)) {
+                return m_tiles[begin(v)];
+            }
+        }
+
+        // Tiles are never added, so if every range is empty, we are done.
+        // Tiles in transit to a thief are handled by the thief.
+        bool found = true;
+        while (found) {
+            found = false;
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            const int first = static_cast<int>(seed % static_cast<std::uint32_t>(m_nranges));
+            for (int k = 0; k < m_nranges; ++k) {
+                const int victim = (first + k) % m_nranges;
+                if (victim == tid) { continue; }
+                auto& theirs = m_ranges[victim].be;
+                auto w = theirs.load(std::memory_order_acquire);
+                while (begin(w) < end(w)) {
+                    found = true;
+                    const std::uint32_t b = begin(w);
+                    const std::uint32_t e = end(w);
+                    const std::uint32_t mid = e - (e-b+1)/2;
+                    if (theirs.compare_exchange_weak(w, pack(b, mid),
+                                                     std::memory_order_acq_rel)) {
+                        mine.store(pack(mid+1, e), std::memory_order_release);
+                        return m_tiles[mid];
+                    }
+                }
+            }
+        }
+        return -1;
+    }
+
+private:
+
+    static std::uint64_t pack (std::uint32_t b, std::uint32_t e) noexcept {
+        return (std::uint64_t(e) << 32) | b;
+    }
+    static std::uint32_t begin (std::uint64_t v) noexcept {
+        return static_cast<std::uint32_t>(v);
+    }
+    static std::uint32_t end (std::uint64_t v) noexcept {
+        return static_cast<std::uint32_t>(v >> 32);
+    }
+
+    struct alignas(64) Range
+    {
+        std::atomic<std::uint64_t> be{0};
+    };
+
+    Vector<int> m_tiles;
+    std::unique_ptr<Range[]> m_ranges;
+    int m_nranges = 0;
+};
+
+DynamicQueues dynamic_queues;
+
+}
+#endif
+
 int MFIter::depth = 0;
 int MFIter::allow_multiple_mfiters = 0;
 
+namespace {
+    // The depth is kept by thread 0 of the outermost team, which is not
+    // omp master because every thread of a ThreadPool task is.  The loops
+    // of a nested team (e.g., a local reduction in a parallel region) are
+    // private to it, and every thread of the enclosing team may be running
+    // one.  That includes the OpenMP teams started in ThreadPool tasks
+    // and by detail::CallInOneThreadTeam.
+    bool tracksDepth ()
+    {
+#ifdef AMREX_USE_OMP
+        if (OpenMP::get_thread_num() != 0 || OpenMP::detail::one_thread_team_level > 0 ||
+            (ThreadPool::InTask() && !OpenMP::detail::in_pool_team())) {
+            return false;
+        }
+        for (int level = omp_get_level()-1; level > 0; --level) {
+            if (omp_get_ancestor_thread_num(level) != 0) { return false; }
+        }
+#endif
+        return true;
+    }
+}
+
 int
 MFIter::allowMultipleMFIters (int allow)
 {
@@ -165,29 +293,31 @@ MFIter::MFIter (const BoxArray& ba, const DistributionMapping& dm, const MFItInf
     tile_size(info.tilesize),
     flags(info.do_tiling ? Tiling : 0),
     streams(std::max(1,std::min(Gpu::numGpuStreams(),info.num_streams))),
-    dynamic(info.dynamic && (OpenMP::get_num_threads() > 1)),
+    dynamic(info.dynamic && (OpenMP::get_num_threads() > 1) && !ThreadPool::InTask()),
     device_sync(info.device_sync),
+    overlap_fb(info.fb_overlap_finish != nullptr),
+    overlap_fb_ngrow(info.fb_overlap_ngrow),
+    overlap_fb_fa(info.fb_overlap_fa),
+    overlap_fb_finish(info.fb_overlap_finish),
     index_map(nullptr),
     local_index_map(nullptr),
     tile_array(nullptr),
     local_tile_index_map(nullptr),
     num_local_tiles(nullptr)
 {
+    if (overlap_fb) {
+        AMREX_ASSERT(info.fb_overlap_fa && isMFIterSafe(*fabArray, *info.fb_overlap_fa));
+        dynamic = false;
+    }
+
+    StartTuning(info);
+
 #ifdef AMREX_USE_OMP
 #pragma omp single
 #endif
     {
         m_fa->addThisBD();
     }
-#ifdef AMREX_USE_OMP
-    if (dynamic) {
-#pragma omp barrier
-#pragma omp single
-        nextDynamicIndex = omp_get_num_threads();
-        // yes omp single has an implicit barrier and we need it because nextDynamicIndex is static.
-    }
-#endif
-
     Initialize();
 }
 
@@ -197,22 +327,24 @@ MFIter::MFIter (const FabArrayBase& fabarray_, const MFItInfo& info)
     tile_size(info.tilesize),
     flags(info.do_tiling ? Tiling : 0),
     streams(std::max(1,std::min(Gpu::numGpuStreams(),info.num_streams))),
-    dynamic(info.dynamic && (OpenMP::get_num_threads() > 1)),
+    dynamic(info.dynamic && (OpenMP::get_num_threads() > 1) && !ThreadPool::InTask()),
     device_sync(info.device_sync),
+    overlap_fb(info.fb_overlap_finish != nullptr),
+    overlap_fb_ngrow(info.fb_overlap_ngrow),
+    overlap_fb_fa(info.fb_overlap_fa),
+    overlap_fb_finish(info.fb_overlap_finish),
     index_map(nullptr),
     local_index_map(nullptr),
     tile_array(nullptr),
     local_tile_index_map(nullptr),
     num_local_tiles(nullptr)
 {
-#ifdef AMREX_USE_OMP
-    if (dynamic) {
-#pragma omp barrier
-#pragma omp single
-        nextDynamicIndex = omp_get_num_threads();
-        // yes omp single has an implicit barrier and we need it because nextDynamicIndex is static.
+    if (overlap_fb) {
+        AMREX_ASSERT(info.fb_overlap_fa && isMFIterSafe(*fabArray, *info.fb_overlap_fa));
+        dynamic = false;
     }
-#endif
+
+    StartTuning(info);
 
     Initialize();
 }
@@ -230,6 +362,16 @@ MFIter::Finalize ()
     if (finalized) { return; }
     finalized = true;
 
+    // The loop has been terminated early.  The other threads might be
+    // waiting for the communication, or they might never get here, so
+    // there must be no barrier.  Thus this is only allowed without a team.
+    if (overlap_fb && !overlap_fb_finished && overlap_fb_finish) {
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(OpenMP::get_num_threads() == 1,
+            "MFIter: an OverlapFillBoundary loop in a parallel region must not be terminated early");
+        overlap_fb_finish(*overlap_fb_fa);
+        overlap_fb_finished = true;
+    }
+
     // mark as invalid
     currentIndex = endIndex;
 
@@ -251,6 +393,22 @@ MFIter::Finalize ()
     Gpu::Device::resetStreamIndex();
 #endif
 
+    if (tuning) {
+#ifdef AMREX_USE_OMP
+#pragma omp barrier
+#pragma omp single
+#endif
+        {
+            const double t = ParallelDescriptor::second() - tune_start;
+            const BoxArray& ba = fabArray->boxArray();
+            Long ncells = 0;
+            for (int i : fabArray->IndexArray()) {
+                ncells += ba[i].numPts();
+            }
+            TileTuner::Record(tune_label, tune_shape, tile_size, t, ncells);
+        }
+    }
+
     if (m_fa) {
 #ifdef AMREX_USE_OMP
 #pragma omp barrier
@@ -262,20 +420,41 @@ MFIter::Finalize ()
         m_fa.reset(nullptr);
     }
 
-#ifdef AMREX_USE_OMP
-#pragma omp master
-#endif
+    if (tracksDepth())
     {
         depth = 0;
     }
 }
 
+void
+MFIter::StartTuning (const MFItInfo& info)
+{
+    if (info.tune_label.empty() || !(flags & Tiling) || !TileTuner::Enabled()
+        || ThreadPool::InTask()) {
+        return;
+    }
+    // The loop is keyed by the largest extent of the local boxes in each
+    // direction, so that a small box (e.g., at the domain boundary) does
+    // not decide the candidate tile sizes.
+    const BoxArray& ba = fabArray->boxArray();
+    IntVect shape(0);
+    for (int i : fabArray->IndexArray()) {
+        shape.max(ba.getCellCenteredBox(i).length());
+    }
+    if (shape == IntVect(0)) { return; }
+    tuning = true;
+    tune_label = info.tune_label;
+    tune_shape = shape;
+    tile_size = TileTuner::TileSize(tune_label, tune_shape);
+}
+
 void
 MFIter::Initialize ()
 {
-#ifdef AMREX_USE_OMP
-#pragma omp master
-#endif
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!ThreadPool::InTask() || (!m_fa && !overlap_fb),
+        "MFIter: a BoxArray or OverlapFillBoundary MFIter cannot be used in a ThreadPool task");
+
+    if (tracksDepth())
     {
         ++depth;
         AMREX_ALWAYS_ASSERT_WITH_MESSAGE(depth == 1 || MFIter::allow_multiple_mfiters,
@@ -291,7 +470,65 @@ MFIter::Initialize ()
     }
 #endif
 
-    if (flags & AllBoxes)  // a very special case
+    if (overlap_fb)
+    {
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!(flags & AllBoxes),
+            "MFIter: AllBoxes cannot be used with OverlapFillBoundary");
+
+        const FabArrayBase::TileArray* pta = fabArray->getSplitTileArray(tile_size, overlap_fb_ngrow);
+
+        index_map            = &(pta->indexMap);
+        local_index_map      = &(pta->localIndexMap);
+        tile_array           = &(pta->tileArray);
+        local_tile_index_map = &(pta->localTileIndexMap);
+        num_local_tiles      = &(pta->numLocalTiles);
+
+        // The interior tiles and the shell tiles are distributed among
+        // threads separately so that every thread participates in both.
+        int ibegin = 0;
+        int iend = pta->numInteriorTiles;
+        int sbegin = iend;
+        int send = static_cast<int>(index_map->size());
+
+#ifdef AMREX_USE_OMP
+        int nthreads = OpenMP::get_num_threads();
+        if (nthreads > 1)
+        {
+            int tid = OpenMP::get_thread_num();
+            auto partition = [=] (int& b, int& e) {
+                int ntot = e - b;
+                int nr   = ntot / nthreads;
+                int nlft = ntot - nr * nthreads;
+                if (tid < nlft) {  // get nr+1 items
+                    b += tid * (nr + 1);
+                    e = b + nr + 1;
+                } else {           // get nr items
+                    b += tid * nr + nlft;
+                    e = b + nr;
+                }
+            };
+            partition(ibegin, iend);
+            partition(sbegin, send);
+        }
+#endif
+
+        beginIndex       = ibegin;
+        interiorEndIndex = iend;
+        shellBeginIndex  = sbegin;
+        endIndex         = send;
+        currentIndex     = beginIndex;
+
+        typ = fabArray->boxArray().ixType();
+
+        if (currentIndex == interiorEndIndex) {
+            FinishOverlapFillBoundary();
+        }
+
+#ifdef AMREX_USE_GPU
+        Gpu::Device::setStreamIndex(currentIndex%streams);
+#endif
+    }
+    else if (flags & AllBoxes)  // a very special case
     {
         index_map    = &(fabArray->IndexArray());
         currentIndex = 0;
@@ -347,16 +584,23 @@ MFIter::Initialize ()
         }
 
 #ifdef AMREX_USE_OMP
-        int nthreads = omp_get_num_threads();
+        int nthreads = OpenMP::get_num_threads();
         if (nthreads > 1)
         {
             if (dynamic)
             {
-                beginIndex = omp_get_thread_num();
+                // The previous dynamic MFIter must be done with the shared queues.
+#pragma omp barrier
+#pragma omp single
+                {
+                    dynamic_queues.setup(pta->mortonOrder, beginIndex, endIndex, nthreads);
+                }
+                dynamic_tid = OpenMP::get_thread_num();
+                dynamic_seed = 2654435761U * static_cast<std::uint32_t>(dynamic_tid+1);
             }
             else
             {
-                int tid = omp_get_thread_num();
+                int tid = OpenMP::get_thread_num();
                 int ntot = endIndex - beginIndex;
                 int nr   = ntot / nthreads;
                 int nlft = ntot - nr * nthreads;
@@ -371,7 +615,7 @@ MFIter::Initialize ()
         }
 #endif
 
-        currentIndex = beginIndex;
+        currentIndex = dynamic ? nextDynamicTile() : beginIndex;
 
 #ifdef AMREX_USE_GPU
         Gpu::Device::setStreamIndex(currentIndex%streams);
@@ -379,6 +623,21 @@ MFIter::Initialize ()
 
         typ = fabArray->boxArray().ixType();
     }
+
+    if (tuning) {
+        tune_start = ParallelDescriptor::second();
+    }
+}
+
+int
+MFIter::nextDynamicTile () noexcept
+{
+#ifdef AMREX_USE_OMP
+    int i = dynamic_queues.pop(dynamic_tid, dynamic_seed);
+    return (i >= 0) ? i : endIndex;
+#else
+    return endIndex;
+#endif
 }
 
 Box
@@ -524,14 +783,17 @@ MFIter::operator++ () noexcept
 #ifdef AMREX_USE_OMP
     if (dynamic)
     {
-#pragma omp atomic capture
-        currentIndex = nextDynamicIndex++;
+        currentIndex = nextDynamicTile();
     }
     else
 #endif
     {
         ++currentIndex;
 
+        if (overlap_fb && currentIndex == interiorEndIndex && !overlap_fb_finished) {
+            FinishOverlapFillBoundary();
+        }
+
 #ifdef AMREX_USE_GPU
         if (Gpu::inLaunchRegion()) {
             Gpu::Device::setStreamIndex(currentIndex%streams);
@@ -544,4 +806,34 @@ MFIter::operator++ () noexcept
     }
 }
 
+void
+MFIter::FinishOverlapFillBoundary ()
+{
+    // Interior tiles do not touch ghost cells, so there is no need to
+    // wait for other threads before the communication is finished.  This
+    // is only called at the end of the interior tiles, which every thread
+    // of the team reaches, so the barrier below is matched.
+#ifdef AMREX_USE_GPU
+    Gpu::Device::resetStreamIndex();
+#endif
+
+#ifdef AMREX_USE_OMP
+#pragma omp master
+#endif
+    {
+        overlap_fb_finish(*overlap_fb_fa);
+    }
+
+#ifdef AMREX_USE_GPU
+    Gpu::streamSynchronize();
+#endif
+
+#ifdef AMREX_USE_OMP
+#pragma omp barrier
+#endif
+
+    overlap_fb_finished = true;
+    currentIndex = std::max(currentIndex, shellBeginIndex);
+}
+
 }
@@ -65,18 +65,20 @@ MultiFab::Dot (const MultiFab& x, int xcomp, int numcomp, int nghost, bool local
     } else
 #endif
     {
-#ifdef AMREX_USE_OMP
-#pragma omp parallel if (!system::regtest_reduction) reduction(+:sm)
-#endif
-        for (MFIter mfi(x,true); mfi.isValid(); ++mfi)
+        sm = ParallelRegionReduce(Plus<Real>(), [&] ()
         {
-            Box const& bx = mfi.growntilebox(nghost);
-            Array4<Real const> const& xfab = x.const_array(mfi);
-            AMREX_LOOP_4D(bx, numcomp, i, j, k, n,
+            Real tsm = Real(0.0);
+            for (MFIter mfi(x,true); mfi.isValid(); ++mfi)
             {
-                sm += xfab(i,j,k,xcomp+n) * xfab(i,j,k,xcomp+n);
-            });
-        }
+                Box const& bx = mfi.growntilebox(nghost);
+                Array4<Real const> const& xfab = x.const_array(mfi);
+                AMREX_LOOP_4D(bx, numcomp, i, j, k, n,
+                {
+                    tsm += xfab(i,j,k,xcomp+n) * xfab(i,j,k,xcomp+n);
+                });
+            }
+            return tsm;
+        }, !system::regtest_reduction);
     }
 
     if (!local) {
@@ -122,22 +124,24 @@ MultiFab::Dot (const iMultiFab& mask,
     } else
 #endif
     {
-#ifdef AMREX_USE_OMP
-#pragma omp parallel if (!system::regtest_reduction) reduction(+:sm)
-#endif
-        for (MFIter mfi(x,true); mfi.isValid(); ++mfi)
+        sm = ParallelRegionReduce(Plus<Real>(), [&] ()
         {
-            Box const& bx = mfi.growntilebox(nghost);
-            Array4<Real const> const& xfab = x.const_array(mfi);
-            Array4<Real const> const& yfab = y.const_array(mfi);
-            Array4<int const> const& mfab = mask.const_array(mfi);
-            AMREX_LOOP_4D(bx, numcomp, i, j, k, n,
+            Real tsm = Real(0.0);
+            for (MFIter mfi(x,true); mfi.isValid(); ++mfi)
             {
-                if (mfab(i,j,k)) {
-                    sm += xfab(i,j,k,xcomp+n) * yfab(i,j,k,ycomp+n);
-                }
-            });
-        }
+                Box const& bx = mfi.growntilebox(nghost);
+                Array4<Real const> const& xfab = x.const_array(mfi);
+                Array4<Real const> const& yfab = y.const_array(mfi);
+                Array4<int const> const& mfab = mask.const_array(mfi);
+                AMREX_LOOP_4D(bx, numcomp, i, j, k, n,
+                {
+                    if (mfab(i,j,k)) {
+                        tsm += xfab(i,j,k,xcomp+n) * yfab(i,j,k,ycomp+n);
+                    }
+                });
+            }
+            return tsm;
+        }, !system::regtest_reduction);
     }
 
     if (!local) {
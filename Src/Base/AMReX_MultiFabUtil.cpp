@@ -1,5 +1,6 @@
 
 #include <AMReX_MultiFabUtil.H>
+#include <AMReX_BumpArena.H>
 #include <AMReX_Random.H>
 #include <sstream>
 #include <iostream>
@@ -346,7 +347,8 @@ namespace amrex
         BoxArray crse_S_fine_BA = fine_BA;
         crse_S_fine_BA.coarsen(ratio);
 
-        MultiFab crse_S_fine(crse_S_fine_BA,fine_dm,ncomp,0,MFInfo(),FArrayBoxFactory());
+        ArenaScope scratch_scope;
+        MultiFab crse_S_fine(crse_S_fine_BA,fine_dm,ncomp,0,MFInfo().SetScratch(),FArrayBoxFactory());
 
         MultiFab fvolume;
         fgeom.GetVolume(fvolume, fine_BA, fine_dm, 0);
@@ -436,8 +438,9 @@ namespace amrex
         BoxArray                    crse_S_fine_BA = FineBA;
         crse_S_fine_BA.coarsen( RefRatio );
 
+        ArenaScope scratch_scope;
         MultiFab crse_S_fine
-          ( crse_S_fine_BA, FineDM, nComp, 0, MFInfo(), FArrayBoxFactory() );
+          ( crse_S_fine_BA, FineDM, nComp, 0, MFInfo().SetScratch(), FArrayBoxFactory() );
 
         // Create MultiFab for SqrtGm on coarse level that uses same DM
         // as dst MultiFab
@@ -531,8 +534,9 @@ namespace amrex
         BoxArray                    crse_S_fine_BA = FineBA;
         crse_S_fine_BA.coarsen( RefRatio );
 
+        ArenaScope scratch_scope;
         MultiFab crse_S_fine
-          ( crse_S_fine_BA, FineDM, nComp, 0, MFInfo(), FArrayBoxFactory() );
+          ( crse_S_fine_BA, FineDM, nComp, 0, MFInfo().SetScratch(), FArrayBoxFactory() );
 
 #ifdef AMREX_USE_GPU
         if ( Gpu::inLaunchRegion() && crse_S_fine.isFusingCandidate() ) {
@@ -613,8 +617,9 @@ namespace amrex
         BoxArray                    crse_S_fine_BA = FineBA;
         crse_S_fine_BA.coarsen( RefRatio );
 
+        ArenaScope scratch_scope;
         MultiFab crse_S_fine
-          ( crse_S_fine_BA, FineDM, nComp, 0, MFInfo(), FArrayBoxFactory() );
+          ( crse_S_fine_BA, FineDM, nComp, 0, MFInfo().SetScratch(), FArrayBoxFactory() );
 
 #ifdef AMREX_USE_GPU
         if ( Gpu::inLaunchRegion() && crse_S_fine.isFusingCandidate() ) {
@@ -678,7 +683,8 @@ namespace amrex
         //
         BoxArray crse_S_fine_BA = S_fine.boxArray(); crse_S_fine_BA.coarsen(ratio);
 
-        MultiFab crse_S_fine(crse_S_fine_BA, S_fine.DistributionMap(), ncomp, nGrow, MFInfo(), FArrayBoxFactory());
+        ArenaScope scratch_scope;
+        MultiFab crse_S_fine(crse_S_fine_BA, S_fine.DistributionMap(), ncomp, nGrow, MFInfo().SetScratch(), FArrayBoxFactory());
 
 #ifdef AMREX_USE_GPU
         if (Gpu::inLaunchRegion() && crse_S_fine.isFusingCandidate()) {
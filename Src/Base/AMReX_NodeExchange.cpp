@@ -0,0 +1,459 @@
+#include <AMReX_NodeExchange.H>
+#include <AMReX_BLProfiler.H>
+#include <AMReX_GpuControl.H>
+#include <AMReX_ParallelContext.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Utility.H>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <memory>
+#include <tuple>
+
+namespace amrex::NodeExchange {
+
+namespace {
+    bool initialized = false;
+    bool use_hierarchical = false;
+
+#ifdef BL_USE_MPI
+    MPI_Comm node_comm = MPI_COMM_NULL;
+    int node_rank = 0;
+    int node_size = 1;
+    int max_node_size = 1;    // over all the nodes
+    Vector<int> node_procs;   // global ranks of the processes on this node
+    Vector<int> node_lead;    // leader of the node for each global rank
+    Vector<int> rank_in_node; // rank in its node for each global rank
+
+    constexpr std::size_t seg_align = 64;
+
+    // Layout of a segment: a header of Longs followed by the data.
+    //   header[0]: number of send entries, ns
+    //   header[1]: number of off-node recv entries, nr
+    //   followed by ns triplets of (dest rank, offset, nbytes)
+    //   followed by nr triplets of (src rank, offset, nbytes)
+    // Offsets are relative to the beginning of the segment.
+    struct Slot
+    {
+        bool in_use = false;
+        bool direct = false; // no messages within the node in this exchange
+        MPI_Win win = MPI_WIN_NULL;
+        std::size_t capacity = 0;
+        Vector<char*> peer_base;
+        Vector<int> recv_from;
+        Vector<int> send_rank;
+        Vector<char*> send_ptr;
+        Vector<std::size_t> send_size;
+        Vector<char*> recv_ptr;
+        Vector<std::size_t> recv_size;
+        Vector<MPI_Request> reqs;
+        Vector<MPI_Datatype> types;
+
+        void free_window () {
+            if (win != MPI_WIN_NULL) {
+                MPI_Win_unlock_all(win);
+                MPI_Win_free(&win);
+            }
+            capacity = 0;
+            peer_base.clear();
+        }
+    };
+
+    Vector<std::unique_ptr<Slot>> slots;
+
+    struct Block
+    {
+        int src;
+        int dst;
+        char* p;
+        std::size_t nbytes;
+    };
+
+    // Build a datatype covering the blocks in (src,dst) order.
+    MPI_Datatype make_type (Vector<Block>& blocks)
+    {
+        std::sort(blocks.begin(), blocks.end(), [] (Block const& a, Block const& b)
+                  { return std::tie(a.src,a.dst) < std::tie(b.src,b.dst); });
+        const auto n = static_cast<int>(blocks.size());
+        Vector<int> lens(n);
+        Vector<MPI_Aint> disps(n);
+        for (int i = 0; i < n; ++i) {
+            AMREX_ALWAYS_ASSERT(blocks[i].nbytes <= static_cast<std::size_t>(std::numeric_limits<int>::max()));
+            lens[i] = static_cast<int>(blocks[i].nbytes);
+            BL_MPI_REQUIRE( MPI_Get_address(blocks[i].p, &disps[i]) );
+        }
+        MPI_Datatype t;
+        BL_MPI_REQUIRE( MPI_Type_create_hindexed(n, lens.data(), disps.data(), MPI_BYTE, &t) );
+        BL_MPI_REQUIRE( MPI_Type_commit(&t) );
+        return t;
+    }
+#endif
+}
+
+void
+Initialize ()
+{
+    if (initialized) { return; }
+    initialized = true;
+
+    ParmParse pp("fabarray");
+    pp.queryAdd("fb_hierarchical", use_hierarchical);
+
+    // If positive, the processes on a node are further divided into
+    // groups of at most this size (e.g., one group per socket).
+    int group_size = 0;
+    pp.queryAdd("fb_hierarchical_group_size", group_size);
+
+#ifdef BL_USE_MPI
+    if (use_hierarchical && ParallelDescriptor::NProcs() > 1)
+    {
+        MPI_Comm comm = ParallelDescriptor::Communicator();
+        BL_MPI_REQUIRE( MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm) );
+        if (group_size > 0) {
+            MPI_Comm_rank(node_comm, &node_rank);
+            MPI_Comm group_comm;
+            BL_MPI_REQUIRE( MPI_Comm_split(node_comm, node_rank/group_size, node_rank, &group_comm) );
+            MPI_Comm_free(&node_comm);
+            node_comm = group_comm;
+        }
+        MPI_Comm_size(node_comm, &node_size);
+        MPI_Comm_rank(node_comm, &node_rank);
+
+        const int myproc = ParallelDescriptor::MyProc();
+        node_procs.resize(node_size);
+        MPI_Allgather(&myproc, 1, MPI_INT, node_procs.data(), 1, MPI_INT, node_comm);
+
+        const int nprocs = ParallelDescriptor::NProcs();
+        node_lead.resize(nprocs);
+        rank_in_node.resize(nprocs);
+        MPI_Allgather(node_procs.data(), 1, MPI_INT, node_lead.data(), 1, MPI_INT, comm);
+        MPI_Allgather(&node_rank, 1, MPI_INT, rank_in_node.data(), 1, MPI_INT, comm);
+
+        // All the processes must agree on whether the exchange is used,
+        // even if some of the nodes have a single process.
+        BL_MPI_REQUIRE( MPI_Allreduce(&node_size, &max_node_size, 1, MPI_INT, MPI_MAX, comm) );
+    }
+#endif
+}
+
+void
+Finalize ()
+{
+#ifdef BL_USE_MPI
+    for (auto& s : slots) {
+        AMREX_ASSERT(!s->in_use);
+        s->free_window();
+    }
+    slots.clear();
+    if (node_comm != MPI_COMM_NULL) {
+        MPI_Comm_free(&node_comm);
+    }
+    node_rank = 0;
+    node_size = 1;
+    max_node_size = 1;
+    node_procs.clear();
+    node_lead.clear();
+    rank_in_node.clear();
+#endif
+    use_hierarchical = false;
+    initialized = false;
+}
+
+bool
+Enabled ()
+{
+#ifdef BL_USE_MPI
+    return use_hierarchical && node_comm != MPI_COMM_NULL && max_node_size > 1
+        && Gpu::notInLaunchRegion()
+        && ParallelContext::CommunicatorSub() == ParallelDescriptor::Communicator();
+#else
+    return false;
+#endif
+}
+
+#ifdef BL_USE_MPI
+
+int
+Begin (Vector<int> const& send_rank, Vector<std::size_t> const& send_size,
+       Vector<int> const& recv_from, Vector<std::size_t> const& recv_size,
+       Vector<char*>& send_data)
+{
+    BL_PROFILE("NodeExchange::Begin()");
+
+    const int myproc = ParallelDescriptor::MyProc();
+    const int mylead = node_lead[myproc];
+
+    const auto ns = static_cast<int>(send_rank.size());
+    const auto nr = static_cast<int>(recv_from.size());
+    int nr_off = 0;
+    for (int i = 0; i < nr; ++i) {
+        if (node_lead[recv_from[i]] != mylead) { ++nr_off; }
+    }
+    int has_local = (nr_off < nr) ? 1 : 0;
+    for (int i = 0; i < ns && !has_local; ++i) {
+        if (node_lead[send_rank[i]] == mylead) { has_local = 1; }
+    }
+
+    std::size_t needed = amrex::aligned_size(seg_align, sizeof(Long)*(2+3*(ns+nr_off)));
+    Vector<std::size_t> send_offset(ns);
+    for (int i = 0; i < ns; ++i) {
+        send_offset[i] = needed;
+        needed += amrex::aligned_size(seg_align, send_size[i]);
+    }
+    Vector<std::size_t> recv_offset(nr, 0);
+    for (int i = 0; i < nr; ++i) {
+        if (node_lead[recv_from[i]] != mylead) {
+            recv_offset[i] = needed;
+            needed += amrex::aligned_size(seg_align, recv_size[i]);
+        }
+    }
+
+    // The first free slot.  This is the same on all processes.
+    int handle = 0;
+    for (; handle < static_cast<int>(slots.size()); ++handle) {
+        if (!slots[handle]->in_use) { break; }
+    }
+    if (handle == static_cast<int>(slots.size())) {
+        slots.emplace_back(std::make_unique<Slot>());
+    }
+    Slot& slot = *slots[handle];
+    slot.in_use = true;
+    slot.recv_from = recv_from;
+
+    // This also guarantees that nobody is still reading from the previous
+    // use of this slot.  The reduction is over all the processes, because
+    // the two ends of a message between nodes must agree on whether it is
+    // sent directly or aggregated by the leaders.  Growing the window is
+    // collective over the node, and the maximum over all the processes is
+    // the same on every process of a node.
+    int flags[2] = {(needed > slot.capacity) ? 1 : 0, has_local};
+    BL_MPI_REQUIRE( MPI_Allreduce(MPI_IN_PLACE, flags, 2, MPI_INT, MPI_MAX,
+                                  ParallelDescriptor::Communicator()) );
+    const int grow = flags[0];
+
+    // Without messages within any node, the processes do not need to read
+    // each other's segments.  Then every process sends and receives its
+    // own messages, and Post and Wait do not synchronize the node.
+    slot.direct = (flags[1] == 0);
+
+    if (grow) {
+        std::size_t new_capacity = std::max(needed, slot.capacity + slot.capacity/2);
+        slot.free_window();
+
+        MPI_Info info;
+        MPI_Info_create(&info);
+        MPI_Info_set(info, "alloc_shared_noncontig", "true");
+        char* base = nullptr;
+        BL_MPI_REQUIRE( MPI_Win_allocate_shared(static_cast<MPI_Aint>(new_capacity), 1, info,
+                                                node_comm, &base, &slot.win) );
+        MPI_Info_free(&info);
+        BL_MPI_REQUIRE( MPI_Win_lock_all(MPI_MODE_NOCHECK, slot.win) );
+
+        slot.capacity = new_capacity;
+        slot.peer_base.resize(node_size);
+        for (int i = 0; i < node_size; ++i) {
+            MPI_Aint sz;
+            int disp;
+            BL_MPI_REQUIRE( MPI_Win_shared_query(slot.win, i, &sz, &disp, &slot.peer_base[i]) );
+        }
+    }
+
+    char* base = slot.peer_base[node_rank];
+    auto* hdr = reinterpret_cast<Long*>(base);
+    hdr[0] = ns;
+    hdr[1] = nr_off;
+    Long* p = hdr + 2;
+    send_data.resize(ns);
+    slot.send_rank = send_rank;
+    slot.send_size = send_size;
+    slot.send_ptr.resize(ns);
+    slot.recv_size = recv_size;
+    slot.recv_ptr.resize(nr);
+    for (int i = 0; i < nr; ++i) {
+        slot.recv_ptr[i] = base + recv_offset[i];
+    }
+    for (int i = 0; i < ns; ++i) {
+        send_data[i] = base + send_offset[i];
+        slot.send_ptr[i] = send_data[i];
+        *p++ = send_rank[i];
+        *p++ = static_cast<Long>(send_offset[i]);
+        *p++ = static_cast<Long>(send_size[i]);
+    }
+    for (int i = 0; i < nr; ++i) {
+        if (node_lead[recv_from[i]] != mylead) {
+            *p++ = recv_from[i];
+            *p++ = static_cast<Long>(recv_offset[i]);
+            *p++ = static_cast<Long>(recv_size[i]);
+        }
+    }
+
+    return handle;
+}
+
+void
+Post (int handle, int tag)
+{
+    BL_PROFILE("NodeExchange::Post()");
+
+    Slot& slot = *slots[handle];
+
+    MPI_Comm comm = ParallelDescriptor::Communicator();
+
+    if (slot.direct)
+    {
+        slot.reqs.clear();
+        const auto nr = static_cast<int>(slot.recv_from.size());
+        for (int i = 0; i < nr; ++i) {
+            if (slot.recv_size[i] > 0) {
+                slot.reqs.push_back(ParallelDescriptor::Arecv(slot.recv_ptr[i], slot.recv_size[i],
+                                                              slot.recv_from[i], tag, comm).req());
+            }
+        }
+        const auto ns = static_cast<int>(slot.send_rank.size());
+        for (int i = 0; i < ns; ++i) {
+            if (slot.send_size[i] > 0) {
+                slot.reqs.push_back(ParallelDescriptor::Asend(slot.send_ptr[i], slot.send_size[i],
+                                                              slot.send_rank[i], tag, comm).req());
+            }
+        }
+        return;
+    }
+
+    BL_MPI_REQUIRE( MPI_Win_sync(slot.win) );
+    BL_MPI_REQUIRE( MPI_Barrier(node_comm) );
+    BL_MPI_REQUIRE( MPI_Win_sync(slot.win) );
+
+    if (node_rank != 0) { return; }
+
+    // The leader aggregates the off-node messages of all processes on this node.
+
+    const int mylead = ParallelDescriptor::MyProc();
+    std::map<int,Vector<Block>> send_blocks; // key: the leader of the destination node
+    std::map<int,Vector<Block>> recv_blocks; // key: the leader of the source node
+    for (int inode = 0; inode < node_size; ++inode) {
+        char* base = slot.peer_base[inode];
+        auto const* hdr = reinterpret_cast<Long const*>(base);
+        const Long ns = hdr[0];
+        const Long nr = hdr[1];
+        Long const* p = hdr + 2;
+        for (Long i = 0; i < ns; ++i, p += 3) {
+            const auto dst = static_cast<int>(p[0]);
+            const auto nbytes = static_cast<std::size_t>(p[2]);
+            if (node_lead[dst] != mylead && nbytes > 0) {
+                send_blocks[node_lead[dst]].push_back({node_procs[inode], dst, base+p[1], nbytes});
+            }
+        }
+        for (Long i = 0; i < nr; ++i, p += 3) {
+            const auto src = static_cast<int>(p[0]);
+            const auto nbytes = static_cast<std::size_t>(p[2]);
+            if (nbytes > 0) {
+                recv_blocks[node_lead[src]].push_back({src, node_procs[inode], base+p[1], nbytes});
+            }
+        }
+    }
+
+    slot.reqs.clear();
+    slot.types.clear();
+    for (auto& [lead, blocks] : recv_blocks) {
+        MPI_Datatype t = make_type(blocks);
+        slot.types.push_back(t);
+        slot.reqs.push_back(MPI_REQUEST_NULL);
+        BL_MPI_REQUIRE( MPI_Irecv(MPI_BOTTOM, 1, t, lead, tag, comm, &slot.reqs.back()) );
+    }
+    for (auto& [lead, blocks] : send_blocks) {
+        MPI_Datatype t = make_type(blocks);
+        slot.types.push_back(t);
+        slot.reqs.push_back(MPI_REQUEST_NULL);
+        BL_MPI_REQUIRE( MPI_Isend(MPI_BOTTOM, 1, t, lead, tag, comm, &slot.reqs.back()) );
+    }
+}
+
+void
+Wait (int handle, Vector<char*>& recv_data)
+{
+    BL_PROFILE("NodeExchange::Wait()");
+
+    Slot& slot = *slots[handle];
+
+    if (slot.direct) {
+        if (!slot.reqs.empty()) {
+            BL_MPI_REQUIRE( MPI_Waitall(static_cast<int>(slot.reqs.size()), slot.reqs.data(),
+                                        MPI_STATUSES_IGNORE) );
+        }
+        slot.reqs.clear();
+        recv_data = slot.recv_ptr;
+        return;
+    }
+
+    if (node_rank == 0) {
+        if (!slot.reqs.empty()) {
+            BL_MPI_REQUIRE( MPI_Waitall(static_cast<int>(slot.reqs.size()), slot.reqs.data(),
+                                        MPI_STATUSES_IGNORE) );
+        }
+        for (auto& t : slot.types) {
+            MPI_Type_free(&t);
+        }
+        slot.reqs.clear();
+        slot.types.clear();
+    }
+
+    BL_MPI_REQUIRE( MPI_Win_sync(slot.win) );
+    BL_MPI_REQUIRE( MPI_Barrier(node_comm) );
+    BL_MPI_REQUIRE( MPI_Win_sync(slot.win) );
+
+    const int myproc = ParallelDescriptor::MyProc();
+    const int mylead = node_lead[myproc];
+
+    auto find_entry = [&] (int inode, int rank, bool send_entry) -> char*
+    {
+        char* base = slot.peer_base[inode];
+        auto const* hdr = reinterpret_cast<Long const*>(base);
+        const Long ns = hdr[0];
+        const Long nr = hdr[1];
+        Long const* p = hdr + 2 + (send_entry ? 0 : 3*ns);
+        const Long n = send_entry ? ns : nr;
+        for (Long i = 0; i < n; ++i, p += 3) {
+            if (p[0] == rank) { return base + p[1]; }
+        }
+        amrex::Abort("NodeExchange::Wait: entry not found");
+        return nullptr;
+    };
+
+    const auto nr = static_cast<int>(slot.recv_from.size());
+    recv_data.resize(nr);
+    for (int i = 0; i < nr; ++i) {
+        const int src = slot.recv_from[i];
+        if (node_lead[src] == mylead) {
+            // directly from the sender's buffer
+            recv_data[i] = find_entry(rank_in_node[src], myproc, true);
+        } else {
+            recv_data[i] = find_entry(node_rank, src, false);
+        }
+    }
+}
+
+void
+End (int handle)
+{
+    slots[handle]->in_use = false;
+}
+
+#else
+
+int Begin (Vector<int> const&, Vector<std::size_t> const&, Vector<int> const&,
+           Vector<std::size_t> const&, Vector<char*>&)
+{
+    return -1;
+}
+
+void Post (int, int) {}
+
+void Wait (int, Vector<char*>&) {}
+
+void End (int) {}
+
+#endif
+
+}
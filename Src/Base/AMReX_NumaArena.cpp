@@ -0,0 +1,354 @@
+#include <AMReX_NumaArena.H>
+#include <AMReX_OpenMP.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParallelReduce.H>
+#include <AMReX_Print.H>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace amrex {
+
+namespace {
+
+    // From linux/mempolicy.h
+    constexpr int Mpol_Preferred  = 1;
+    constexpr int Mpol_Interleave = 3;
+    constexpr unsigned Mpol_MF_Move = 1U << 1;
+
+    // The node of the NodeScope alive on this thread
+    thread_local int scope_node = -1;
+
+    Vector<int> const& numa_nodes ()
+    {
+        static Vector<int> nodes = [] ()
+        {
+            Vector<int> r;
+#if defined(__linux__) && defined(SYS_mbind) && defined(SYS_getcpu)
+            // e.g., "0-1" or "0,2-3"
+            std::ifstream ifs("/sys/devices/system/node/online");
+            std::string line;
+            if (ifs && std::getline(ifs, line)) {
+                std::istringstream iss(line);
+                std::string range;
+                while (std::getline(iss, range, ',')) {
+                    auto dash = range.find('-');
+                    int lo = std::stoi(range.substr(0, dash));
+                    int hi = (dash == std::string::npos) ? lo : std::stoi(range.substr(dash+1));
+                    for (int i = lo; i <= hi; ++i) { r.push_back(i); }
+                }
+            }
+#endif
+            if (r.empty()) { r.push_back(0); }
+            return r;
+        }();
+        return nodes;
+    }
+
+#if defined(__linux__) && defined(SYS_mbind)
+    void mbind_range (void* p, std::size_t nbytes, int mode, Vector<int> const& nodes)
+    {
+        static const auto page_size = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+        auto lo = (reinterpret_cast<std::uintptr_t>(p) + page_size - 1) / page_size * page_size;
+        auto hi = (reinterpret_cast<std::uintptr_t>(p) + nbytes) / page_size * page_size;
+        if (hi <= lo) { return; }
+
+        constexpr int nbits = 8 * sizeof(unsigned long);
+        const int maxnode = *std::max_element(nodes.begin(), nodes.end()) + 1;
+        Vector<unsigned long> mask((maxnode+nbits-1)/nbits, 0UL);
+        for (int n : nodes) {
+            mask[n/nbits] |= 1UL << (n%nbits);
+        }
+        // If it fails (e.g., because of a restrictive cpuset), the default
+        // first touch placement is used.
+        syscall(SYS_mbind, lo, hi-lo, mode, mask.data(),
+                static_cast<unsigned long>(mask.size()*nbits), Mpol_MF_Move);
+    }
+#endif
+}
+
+NumaArena::NumaArena (bool interleave_serial, std::size_t hunk_size, ArenaInfo info)
+    : m_interleave_serial(interleave_serial),
+      m_owner_shards(std::make_unique<OwnerShard[]>(NumOwnerShards))
+{
+    info.SetCpuMemory();
+    arena_info = info;
+    const int nnodes = NumNodes();
+    for (int i = 0; i < nnodes; ++i) {
+        m_pools.push_back(std::make_unique<CArena>(hunk_size, ArenaInfo(info)
+                                                   .SetNumaNode(nnodes > 1 ? i : -1)));
+    }
+    m_pools.push_back(std::make_unique<CArena>(hunk_size, ArenaInfo(info)
+                                               .SetNumaNode(nnodes > 1 ? ArenaInfo::NumaInterleave : -1)));
+}
+
+NumaArena::~NumaArena () = default;
+
+void*
+NumaArena::alloc (std::size_t nbytes)
+{
+    int ipool;
+    if (OpenMP::in_parallel()) {
+        ipool = CurrentNode();
+    } else if (scope_node >= 0) {
+        ipool = scope_node;
+    } else {
+        ipool = m_interleave_serial ? NumNodes() : CurrentNode();
+    }
+    void* p = m_pools[ipool]->alloc(nbytes);
+    m_profiler.profile_alloc(p, nbytes);
+    auto& shard = owner_shard(p);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.owner.emplace(p, ipool);
+    return p;
+}
+
+void
+NumaArena::free (void* vp)
+{
+    if (vp == nullptr) { return; }
+
+    int ipool;
+    {
+        auto& shard = owner_shard(vp);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.owner.find(vp);
+        if (it == shard.owner.end()) {
+            amrex::Abort("NumaArena::free: unknown pointer");
+            return;
+        }
+        ipool = it->second;
+        shard.owner.erase(it);
+    }
+    m_profiler.profile_free(vp);
+    m_pools[ipool]->free(vp);
+}
+
+NumaArena::OwnerShard&
+NumaArena::owner_shard (void* p) const noexcept
+{
+    // The blocks are aligned to Arena::align_size.
+    const auto i = (reinterpret_cast<std::uintptr_t>(p) / Arena::align_size) % NumOwnerShards;
+    return m_owner_shards[i];
+}
+
+std::size_t
+NumaArena::freeUnused ()
+{
+    std::size_t nbytes = 0;
+    for (auto const& pool : m_pools) {
+        nbytes += pool->freeUnused();
+    }
+    return nbytes;
+}
+
+bool
+NumaArena::isDeviceAccessible () const
+{
+    return false;
+}
+
+bool
+NumaArena::isHostAccessible () const
+{
+    return true;
+}
+
+bool
+NumaArena::isManaged () const
+{
+    return false;
+}
+
+bool
+NumaArena::isDevice () const
+{
+    return false;
+}
+
+bool
+NumaArena::isPinned () const
+{
+    return false;
+}
+
+std::size_t
+NumaArena::heap_space_used (int node) const
+{
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(node == ArenaInfo::NumaInterleave
+                                     || (node >= 0 && node < NumNodes()),
+                                     "NumaArena::heap_space_used: invalid node");
+    const int ipool = (node == ArenaInfo::NumaInterleave) ? NumNodes() : node;
+    return m_pools[ipool]->heap_space_used();
+}
+
+void
+NumaArena::PrintUsage (std::string const& name) const
+{
+    Long used = 0, actually_used = 0;
+    for (auto const& pool : m_pools) {
+        used += static_cast<Long>(pool->heap_space_used());
+        actually_used += static_cast<Long>(pool->heap_space_actually_used());
+    }
+    Long min_megabytes = used / (1024*1024);
+    Long max_megabytes = min_megabytes;
+    Long actual_min_megabytes = actually_used / (1024*1024);
+    Long actual_max_megabytes = actual_min_megabytes;
+    const int IOProc = ParallelDescriptor::IOProcessorNumber();
+    ParallelReduce::Min<Long>({min_megabytes, actual_min_megabytes},
+                              IOProc, ParallelDescriptor::Communicator());
+    ParallelReduce::Max<Long>({max_megabytes, actual_max_megabytes},
+                              IOProc, ParallelDescriptor::Communicator());
+#ifdef AMREX_USE_MPI
+    amrex::Print() << "[" << name << "] space (MB) allocated spread across MPI: ["
+                   << min_megabytes << " ... " << max_megabytes << "]\n"
+                   << "[" << name << "] space (MB) used      spread across MPI: ["
+                   << actual_min_megabytes << " ... " << actual_max_megabytes << "]\n";
+#else
+    amrex::Print() << "[" << name << "] space allocated (MB): " << min_megabytes << "\n";
+    amrex::Print() << "[" << name << "] space used      (MB): " << actual_min_megabytes << "\n";
+#endif
+    if (arena_info.use_hugepages) {
+        Long huge = 0;
+        for (auto const& pool : m_pools) {
+            huge += static_cast<Long>(pool->heap_space_hugepage_backed());
+        }
+        Long huge_min_megabytes = huge / (1024*1024);
+        Long huge_max_megabytes = huge_min_megabytes;
+        ParallelReduce::Min<Long>(huge_min_megabytes, IOProc, ParallelDescriptor::Communicator());
+        ParallelReduce::Max<Long>(huge_max_megabytes, IOProc, ParallelDescriptor::Communicator());
+#ifdef AMREX_USE_MPI
+        amrex::Print() << "[" << name << "] space (MB) in huge pages spread across MPI: ["
+                       << huge_min_megabytes << " ... " << huge_max_megabytes << "]\n";
+#else
+        amrex::Print() << "[" << name << "] space in huge pages (MB): " << huge_min_megabytes << "\n";
+#endif
+    }
+}
+
+void
+NumaArena::PrintUsage (std::ostream& os, std::string const& name, std::string const& space) const
+{
+    const int nnodes = NumNodes();
+    for (int i = 0; i <= nnodes; ++i) {
+        std::string pool_name = name + ((i < nnodes) ? " node " + std::to_string(numa_nodes()[i])
+                                                     : std::string(" interleaved"));
+        m_pools[i]->PrintUsage(os, pool_name, space);
+    }
+}
+
+void
+NumaArena::PrintDiagnostics (std::ostream& os, std::string const& name, std::string const& space) const
+{
+    const int nnodes = NumNodes();
+    for (int i = 0; i <= nnodes; ++i) {
+        std::string pool_name = name + ((i < nnodes) ? " node " + std::to_string(numa_nodes()[i])
+                                                     : std::string(" interleaved"));
+        m_pools[i]->PrintDiagnostics(os, pool_name, space);
+    }
+}
+
+void
+NumaArena::PrintDiagnostics (std::string const& name) const
+{
+    const int nnodes = NumNodes();
+    for (int i = 0; i <= nnodes; ++i) {
+        std::string pool_name = name + ((i < nnodes) ? " node " + std::to_string(numa_nodes()[i])
+                                                     : std::string(" interleaved"));
+        m_pools[i]->PrintDiagnostics(pool_name);
+    }
+}
+
+int
+NumaArena::NumNodes ()
+{
+    return static_cast<int>(numa_nodes().size());
+}
+
+int
+NumaArena::CurrentNode ()
+{
+    auto const& nodes = numa_nodes();
+    if (nodes.size() == 1) { return 0; }
+#if defined(__linux__) && defined(SYS_getcpu)
+    unsigned cpu = 0, node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+        auto it = std::find(nodes.begin(), nodes.end(), static_cast<int>(node));
+        if (it != nodes.end()) {
+            return static_cast<int>(it - nodes.begin());
+        }
+    }
+#endif
+    return 0;
+}
+
+int
+NumaArena::ThreadNode (int tid)
+{
+    static std::mutex mutex;
+    static Vector<int> thread_nodes;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    const int nthreads = OpenMP::get_max_threads();
+    if (static_cast<int>(thread_nodes.size()) != nthreads) {
+        thread_nodes.assign(nthreads, 0);
+#ifdef AMREX_USE_OMP
+        if (NumNodes() > 1 && !OpenMP::in_parallel()) {
+#pragma omp parallel num_threads(nthreads)
+            thread_nodes[omp_get_thread_num()] = CurrentNode();
+        }
+#endif
+    }
+    return thread_nodes[tid % nthreads];
+}
+
+int
+NumaArena::OwnerNode (int i, int n)
+{
+    if (OpenMP::in_parallel()) { return -1; }
+    if (NumNodes() == 1) { return 0; }
+
+    // The same static schedule as MFIter
+    const int nthreads = OpenMP::get_max_threads();
+    const int nr = n / nthreads;
+    const int nlft = n - nr*nthreads;
+    const int tid = (i < nlft*(nr+1)) ? i/(nr+1) : nlft + (i-nlft*(nr+1))/nr;
+    return ThreadNode(tid);
+}
+
+NumaArena::NodeScope::NodeScope (int node) noexcept
+    : m_prev(scope_node)
+{
+    if (node >= 0) { scope_node = node; }
+}
+
+NumaArena::NodeScope::~NodeScope ()
+{
+    scope_node = m_prev;
+}
+
+void
+NumaArena::Bind (void* p, std::size_t nbytes, int node)
+{
+    amrex::ignore_unused(p, nbytes, node);
+#if defined(__linux__) && defined(SYS_mbind)
+    auto const& nodes = numa_nodes();
+    if (nodes.size() == 1) { return; }
+    if (node == ArenaInfo::NumaInterleave) {
+        mbind_range(p, nbytes, Mpol_Interleave, nodes);
+    } else {
+        mbind_range(p, nbytes, Mpol_Preferred, Vector<int>{nodes[node]});
+    }
+#endif
+}
+
+}
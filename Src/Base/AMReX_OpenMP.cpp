@@ -135,6 +135,12 @@ namespace amrex
 #ifdef AMREX_USE_OMP
 namespace amrex::OpenMP
 {
+    namespace detail {
+        thread_local int pool_thread_num = 0;
+        thread_local int pool_num_threads = 0;
+        thread_local int one_thread_team_level = 0;
+    }
+
     namespace {
         constexpr int nlocks = 128;
 #if defined(_WIN32)
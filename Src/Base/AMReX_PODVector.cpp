@@ -6,10 +6,6 @@ namespace amrex::VectorGrowthStrategy
 {
     Real growth_factor = 1.5_rt;
 
-    // clamp user input to reasonable values
-    constexpr Real min_factor = 1.001_rt;
-    constexpr Real max_factor = 4._rt;
-
     namespace detail
     {
         void ValidateUserInput() {
@@ -1123,6 +1123,20 @@ Waitsome (Vector<MPI_Request>& reqs, int& completed,
     BL_COMM_PROFILE_WAITSOME(BLProfiler::Waitsome, reqs, indx.size(), status, false);
 }
 
+void
+Testsome (Vector<MPI_Request>& reqs, int& completed,
+          Vector<int>& indx, Vector<MPI_Status>& status)
+{
+    BL_ASSERT(status.size() >= reqs.size());
+    BL_ASSERT(indx.size() >= reqs.size());
+
+    BL_MPI_REQUIRE( MPI_Testsome(reqs.size(),
+                                 reqs.dataPtr(),
+                                 &completed,
+                                 indx.dataPtr(),
+                                 status.dataPtr()));
+}
+
 void
 Bcast(void *buf, int count, MPI_Datatype datatype, int root, MPI_Comm comm)
 {
@@ -1304,6 +1318,11 @@ Waitsome (Vector<MPI_Request>& /*reqs*/, int& /*completed*/,
           Vector<int>& /*indx*/, Vector<MPI_Status>& /*status*/)
 {}
 
+void
+Testsome (Vector<MPI_Request>& /*reqs*/, int& /*completed*/,
+          Vector<int>& /*indx*/, Vector<MPI_Status>& /*status*/)
+{}
+
 #endif
 
 #ifndef BL_NO_FORT
@@ -0,0 +1,150 @@
+#include <AMReX_RecycleArena.H>
+
+namespace amrex {
+
+RecycleArena::RecycleArena (Arena* parent, std::size_t granularity)
+    : m_parent(parent),
+      m_granularity(granularity > 0 ? granularity : Arena::align_size)
+{
+    arena_info = this->parent()->arenaInfo();
+}
+
+RecycleArena::~RecycleArena ()
+{
+    for (auto const& [sz, b] : m_pool) {
+        parent()->free(b.p);
+    }
+}
+
+Arena*
+RecycleArena::parent () const noexcept
+{
+    return m_parent ? m_parent : The_Arena();
+}
+
+void*
+RecycleArena::alloc (std::size_t nbytes)
+{
+    const std::size_t sz = (nbytes + m_granularity - 1) / m_granularity * m_granularity;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_pool.lower_bound(sz);
+        if (it != m_pool.end() && it->first <= sz + sz/8) {
+            void* p = it->second.p;
+            m_busy.emplace(p, it->first);
+            m_pooled_bytes -= it->first;
+            m_pool.erase(it);
+            ++m_nhits;
+            return p;
+        }
+        ++m_nmisses;
+    }
+    void* p = parent()->alloc(sz);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_busy.emplace(p, sz);
+    return p;
+}
+
+void
+RecycleArena::free (void* vp)
+{
+    if (vp == nullptr) { return; }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_busy.find(vp);
+    if (it == m_busy.end()) {
+        amrex::Abort("RecycleArena::free: unknown pointer");
+        return;
+    }
+    m_pool.emplace(it->second, Block{vp, m_generation});
+    m_pooled_bytes += it->second;
+    m_busy.erase(it);
+}
+
+std::size_t
+RecycleArena::freeUnused ()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const std::size_t nbytes = m_pooled_bytes;
+    for (auto const& [sz, b] : m_pool) {
+        parent()->free(b.p);
+    }
+    m_pool.clear();
+    m_pooled_bytes = 0;
+    return nbytes;
+}
+
+std::size_t
+RecycleArena::ReleaseStale ()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::size_t nbytes = 0;
+    for (auto it = m_pool.begin(); it != m_pool.end(); ) {
+        if (it->second.generation < m_generation) {
+            parent()->free(it->second.p);
+            nbytes += it->first;
+            it = m_pool.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    m_pooled_bytes -= nbytes;
+    ++m_generation;
+    m_nhits = 0;
+    m_nmisses = 0;
+    return nbytes;
+}
+
+bool
+RecycleArena::isDeviceAccessible () const
+{
+    return parent()->isDeviceAccessible();
+}
+
+bool
+RecycleArena::isHostAccessible () const
+{
+    return parent()->isHostAccessible();
+}
+
+bool
+RecycleArena::isManaged () const
+{
+    return parent()->isManaged();
+}
+
+bool
+RecycleArena::isDevice () const
+{
+    return parent()->isDevice();
+}
+
+bool
+RecycleArena::isPinned () const
+{
+    return parent()->isPinned();
+}
+
+#ifdef AMREX_USE_GPU
+bool
+RecycleArena::isStreamOrderedArena () const
+{
+    return parent()->isStreamOrderedArena();
+}
+#endif
+
+std::size_t
+RecycleArena::pooled_bytes () const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pooled_bytes;
+}
+
+std::pair<Long,Long>
+RecycleArena::hits_and_misses () const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::make_pair(m_nhits, m_nmisses);
+}
+
+}
@@ -0,0 +1,272 @@
+#include <AMReX_ThreadPool.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#ifdef AMREX_USE_OMP
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#endif
+
+namespace amrex::ThreadPool {
+
+#ifdef AMREX_USE_OMP
+
+namespace {
+    bool use_pool = false;
+    int  spin = 100000;
+    bool pin = true;
+    int  nthreads = 1;
+
+    std::vector<std::thread> workers;
+
+    std::mutex pool_mutex;
+    std::condition_variable pool_cond;
+    alignas(64) std::atomic<std::uint64_t> generation{0};
+    alignas(64) std::atomic<int> pending{0};
+    std::atomic<bool> busy{false};
+    bool stopping = false;
+
+    void (*task_f)(void*, int) = nullptr;
+    void* task_ctx = nullptr;
+
+    void cpu_relax () noexcept
+    {
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) && defined(__GNUC__)
+        asm volatile("yield");
+#endif
+    }
+
+    void run_task (int tid)
+    {
+        // An OpenMP parallel region in the task (e.g., a local reduction)
+        // is run by a team of one thread.
+        const int omp_nthreads = omp_get_max_threads();
+        omp_set_num_threads(1);
+        OpenMP::detail::pool_thread_num = tid;
+        OpenMP::detail::pool_num_threads = nthreads;
+        task_f(task_ctx, tid);
+        OpenMP::detail::pool_num_threads = 0;
+        OpenMP::detail::pool_thread_num = 0;
+        omp_set_num_threads(omp_nthreads);
+    }
+
+    void worker (int tid)
+    {
+        std::uint64_t seen = 0;
+        while (true) {
+            std::uint64_t g = generation.load(std::memory_order_acquire);
+            for (int n = 0; g == seen && n < spin; ++n) {
+                cpu_relax();
+                g = generation.load(std::memory_order_acquire);
+            }
+            if (g == seen) {
+                std::unique_lock<std::mutex> lock(pool_mutex);
+                pool_cond.wait(lock, [&] () {
+                    return generation.load(std::memory_order_acquire) != seen;
+                });
+                g = generation.load(std::memory_order_acquire);
+            }
+            seen = g;
+            if (stopping) { return; }
+            run_task(tid);
+            pending.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    // Start a new generation of tasks.  The mutex makes sure that a
+    // worker going to sleep does not miss it.
+    void wake_workers ()
+    {
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            generation.fetch_add(1, std::memory_order_release);
+        }
+        pool_cond.notify_all();
+    }
+
+#if defined(__linux__)
+    // The CPUs this process may run on, with one CPU of every physical
+    // core first, and then their other hardware threads.
+    std::vector<int> cpu_order ()
+    {
+        std::vector<int> first, rest;
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        if (sched_getaffinity(0, sizeof(mask), &mask) != 0) { return first; }
+        std::set<std::string> cores;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (!CPU_ISSET(cpu, &mask)) { continue; }
+            std::ifstream ifs("/sys/devices/system/cpu/cpu" + std::to_string(cpu)
+                              + "/topology/thread_siblings_list");
+            std::string siblings;
+            if (!std::getline(ifs, siblings) || siblings.empty()) {
+                siblings = std::to_string(cpu);
+            }
+            if (cores.insert(siblings).second) {
+                first.push_back(cpu);
+            } else {
+                rest.push_back(cpu);
+            }
+        }
+        first.insert(first.end(), rest.begin(), rest.end());
+        return first;
+    }
+
+    bool pin_thread (std::thread& t, int cpu)
+    {
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        CPU_SET(cpu, &mask);
+        return pthread_setaffinity_np(t.native_handle(), sizeof(mask), &mask) == 0;
+    }
+#endif
+}
+
+void
+Initialize ()
+{
+    if (!workers.empty()) { return; }
+
+    ParmParse pp("amrex");
+    pp.queryAdd("thread_pool", use_pool);
+    pp.queryAdd("thread_pool_spin", spin);
+    pp.queryAdd("thread_pool_pin", pin);
+
+    nthreads = OpenMP::get_max_threads();
+    if (!use_pool || nthreads <= 1) {
+        nthreads = 1;
+        return;
+    }
+
+    stopping = false;
+    generation = 0;
+    pending = 0;
+
+    bool pinned = false;
+#if defined(__linux__)
+    // The calling thread is not pinned, because the threads it creates
+    // later (e.g., OpenMP threads) would inherit its affinity.  It is
+    // left the first CPU.
+    std::vector<int> cpus = cpu_order();
+    const auto ncpus = static_cast<int>(cpus.size());
+    pinned = pin && ncpus >= nthreads;
+#else
+    const auto ncpus = static_cast<int>(std::thread::hardware_concurrency());
+#endif
+    // Spinning threads would take the CPUs from each other.
+    if (ncpus > 0 && ncpus < nthreads) {
+        spin = 0;
+    }
+
+    workers.reserve(nthreads-1);
+    for (int tid = 1; tid < nthreads; ++tid) {
+        workers.emplace_back(worker, tid);
+#if defined(__linux__)
+        if (pinned) {
+            pinned = pin_thread(workers.back(), cpus[tid]);
+        }
+#endif
+    }
+
+    if (system::verbose > 0) {
+        amrex::Print() << "ThreadPool initialized with " << nthreads << " threads"
+                       << (pinned ? " (pinned)" : "") << "\n";
+    }
+}
+
+void
+Finalize ()
+{
+    if (!workers.empty()) {
+        stopping = true;
+        wake_workers();
+        for (auto& t : workers) {
+            t.join();
+        }
+        workers.clear();
+    }
+    nthreads = 1;
+}
+
+bool
+Active () noexcept
+{
+    return !workers.empty() && OpenMP::detail::pool_num_threads == 0
+        && !omp_in_parallel() && Gpu::notInLaunchRegion();
+}
+
+bool
+InTask () noexcept
+{
+    return OpenMP::detail::pool_num_threads > 0;
+}
+
+int
+NumThreads () noexcept
+{
+    return nthreads;
+}
+
+bool
+Run (void (*f)(void*, int), void* ctx)
+{
+    if (workers.empty()) {
+        f(ctx, 0);
+        return true;
+    }
+
+    bool expected = false;
+    if (!busy.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+        return false;
+    }
+
+    task_f = f;
+    task_ctx = ctx;
+    pending.store(nthreads-1, std::memory_order_relaxed);
+    wake_workers();
+
+    run_task(0);
+
+    for (int n = 0; pending.load(std::memory_order_acquire) > 0; ++n) {
+        if (n < spin) {
+            cpu_relax();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    busy.store(false, std::memory_order_release);
+    return true;
+}
+
+#else
+
+void Initialize () {}
+void Finalize () {}
+bool Active () noexcept { return false; }
+bool InTask () noexcept { return false; }
+int NumThreads () noexcept { return 1; }
+
+bool
+Run (void (*f)(void*, int), void* ctx)
+{
+    f(ctx, 0);
+    return true;
+}
+
+#endif
+
+}
@@ -0,0 +1,310 @@
+#include <AMReX_TileGraph.H>
+#include <AMReX_BLProfiler.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_OpenMP.H>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace amrex {
+
+struct TileGraph::State
+{
+    std::unique_ptr<std::atomic<int>[]> npending;
+    std::atomic<int> ndone{0};
+    std::mutex ready_mutex;
+    //! Used as a stack, so that a task whose dependencies have just been
+    //! satisfied runs next, while its data are still in cache.
+    Vector<int> ready;
+    //! The tasks still waiting for the ghost cells of each box, for each FillBoundary
+    Vector<std::map<int,Vector<int>>> gated;
+};
+
+Box
+TileGraph::Tile::tilebox () const noexcept
+{
+    Box bx(m_tile);
+    const IndexType typ = m_valid.ixType();
+    if (! typ.cellCentered())
+    {
+        bx.convert(typ);
+        const IntVect& Big = m_valid.bigEnd();
+        for (int d=0; d<AMREX_SPACEDIM; ++d) {
+            if (typ.nodeCentered(d) && bx.bigEnd(d) < Big[d]) {
+                bx.growHi(d,-1);
+            }
+        }
+    }
+    return bx;
+}
+
+Box
+TileGraph::Tile::tilebox (const IntVect& nodal) const noexcept
+{
+    Box bx(m_tile);
+    const IndexType new_typ {nodal};
+    if (! new_typ.cellCentered())
+    {
+        bx.setType(new_typ);
+        const Box& valid_cc_box = amrex::enclosedCells(m_valid);
+        const IntVect& Big = valid_cc_box.bigEnd();
+        for (int d=0; d<AMREX_SPACEDIM; ++d) {
+            if (new_typ.nodeCentered(d) && bx.bigEnd(d) == Big[d]) {
+                bx.growHi(d,1);
+            }
+        }
+    }
+    return bx;
+}
+
+Box
+TileGraph::Tile::growntilebox (const IntVect& ng) const noexcept
+{
+    Box bx = tilebox();
+    const Box& vbx = m_valid;
+    for (int d=0; d<AMREX_SPACEDIM; ++d) {
+        if (bx.smallEnd(d) == vbx.smallEnd(d)) {
+            bx.growLo(d, ng[d]);
+        }
+        if (bx.bigEnd(d) == vbx.bigEnd(d)) {
+            bx.growHi(d, ng[d]);
+        }
+    }
+    return bx;
+}
+
+Box
+TileGraph::Tile::nodaltilebox (int dir) const noexcept
+{
+    AMREX_ASSERT(dir < AMREX_SPACEDIM);
+    IntVect nodal = m_valid.ixType().toIntVect();
+    if (dir < 0) {
+        nodal = IntVect::TheNodeVector();
+    } else {
+        nodal[dir] = 1;
+    }
+    return tilebox(nodal);
+}
+
+TileGraph::TileGraph (const FabArrayBase& fa, const IntVect& tilesize)
+    : m_fa(&fa),
+      m_state(std::make_unique<State>())
+{
+    auto const* ta = fa.getTileArray(tilesize);
+    const auto ntiles = static_cast<int>(ta->tileArray.size());
+    m_tiles.resize(ntiles);
+    for (int i = 0; i < ntiles; ++i) {
+        auto& t = m_tiles[i];
+        t.m_tile = ta->tileArray[i];
+        t.m_index = ta->indexMap[i];
+        t.m_local_tile = ta->localTileIndexMap[i];
+        t.m_valid = fa.box(t.m_index);
+        m_box_tiles[t.m_index].push_back(i);
+    }
+}
+
+TileGraph::~TileGraph () = default;
+
+void
+TileGraph::addFillBoundary (const FabArrayBase& fa, std::function<void()> start,
+                            std::function<bool(Vector<int>&)> progress)
+{
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(isMFIterSafe(*m_fa, fa),
+                                     "TileGraph: incompatible FabArray");
+    for (auto const& stage : m_stages) {
+        for (auto const& a : stage.accesses) {
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(a.fa != &fa || (!a.write && a.ngrow == 0),
+                "TileGraph: FillBoundary must come before the stages writing the FabArray or accessing its ghost cells");
+        }
+    }
+    for (auto const& fb : m_fbs) {
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(fb.fa != &fa,
+                                         "TileGraph: only one FillBoundary per FabArray");
+    }
+    m_fbs.push_back(FBNode{&fa, std::move(start), std::move(progress), {}});
+    m_built = false;
+}
+
+void
+TileGraph::addStage (Vector<Access> accesses, std::function<void(Tile const&)> f)
+{
+    for (auto const& a : accesses) {
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(a.fa && isMFIterSafe(*m_fa, *a.fa),
+                                         "TileGraph: incompatible FabArray");
+    }
+    m_stages.push_back(Stage{std::move(accesses), std::move(f)});
+    m_built = false;
+}
+
+void
+TileGraph::build ()
+{
+    const int ntiles = numTiles();
+    const int ntasks = numStages() * ntiles;
+
+    m_succ.clear();
+    m_succ.resize(ntasks);
+    m_npreds.clear();
+    m_npreds.resize(ntasks, 0);
+    for (auto& fb : m_fbs) { fb.gated.clear(); }
+
+    Vector<int> preds;
+    for (int s = 0; s < numStages(); ++s) {
+        for (auto const& [K, tiles] : m_box_tiles) {
+            for (int t : tiles) {
+                preds.clear();
+                const int task = s*ntiles + t;
+                for (auto const& a : m_stages[s].accesses) {
+                    // In the index space of the FabArray, so that tiles sharing nodes overlap
+                    const IndexType typ = a.fa->boxArray().ixType();
+                    const Box& region = amrex::grow(amrex::convert(m_tiles[t].m_tile, typ), a.ngrow);
+                    for (int s0 = 0; s0 < s; ++s0) {
+                        for (auto const& a0 : m_stages[s0].accesses) {
+                            if (a0.fa != a.fa || !(a.write || a0.write)) { continue; }
+                            for (int t0 : tiles) {
+                                if (region.intersects(amrex::grow(amrex::convert(m_tiles[t0].m_tile, typ),
+                                                                  a0.ngrow))) {
+                                    preds.push_back(s0*ntiles + t0);
+                                }
+                            }
+                        }
+                    }
+                    if (a.ngrow != 0) {
+                        for (auto& fb : m_fbs) {
+                            if (fb.fa == a.fa) {
+                                auto& g = fb.gated[K];
+                                if (g.empty() || g.back() != task) {
+                                    g.push_back(task);
+                                    ++m_npreds[task];
+                                }
+                            }
+                        }
+                    }
+                }
+                std::sort(preds.begin(), preds.end());
+                preds.erase(std::unique(preds.begin(), preds.end()), preds.end());
+                for (int p : preds) {
+                    m_succ[p].push_back(task);
+                }
+                m_npreds[task] += static_cast<int>(preds.size());
+            }
+        }
+    }
+
+    m_state->npending = std::make_unique<std::atomic<int>[]>(ntasks);
+    m_built = true;
+}
+
+void
+TileGraph::run_task (int task)
+{
+    const int ntiles = numTiles();
+    m_stages[task/ntiles].f(m_tiles[task%ntiles]);
+    for (int succ : m_succ[task]) {
+        release(succ);
+    }
+    m_state->ndone.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void
+TileGraph::release (int task)
+{
+    if (m_state->npending[task].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> lock(m_state->ready_mutex);
+        m_state->ready.push_back(task);
+    }
+}
+
+int
+TileGraph::pop ()
+{
+    std::lock_guard<std::mutex> lock(m_state->ready_mutex);
+    if (m_state->ready.empty()) { return -1; }
+    int task = m_state->ready.back();
+    m_state->ready.pop_back();
+    return task;
+}
+
+void
+TileGraph::poll_fillboundary (Vector<char>& fb_done, int& nfb_done)
+{
+    Vector<int> boxes;
+    for (int i = 0; i < static_cast<int>(m_fbs.size()); ++i) {
+        if (fb_done[i]) { continue; }
+        auto& gated = m_state->gated[i];
+        boxes.clear();
+        const bool done = m_fbs[i].progress(boxes);
+        for (int K : boxes) {
+            auto it = gated.find(K);
+            if (it != gated.end()) {
+                for (int task : it->second) { release(task); }
+                gated.erase(it);
+            }
+        }
+        if (done) {
+            for (auto const& [K, tasks] : gated) {
+                for (int task : tasks) { release(task); }
+            }
+            gated.clear();
+            fb_done[i] = 1;
+            ++nfb_done;
+        }
+    }
+}
+
+void
+TileGraph::execute ()
+{
+    BL_PROFILE("TileGraph::execute()");
+
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!OpenMP::in_parallel(),
+                                     "TileGraph::execute cannot be called in OpenMP parallel regions");
+
+    if (!m_built) { build(); }
+
+    const int ntasks = numStages() * numTiles();
+    auto& state = *m_state;
+    state.ndone = 0;
+    state.ready.clear();
+    for (int i = 0; i < ntasks; ++i) {
+        state.npending[i] = m_npreds[i];
+        if (m_npreds[i] == 0) { state.ready.push_back(i); }
+    }
+    // Stage 0 first, tile 0 on top
+    std::reverse(state.ready.begin(), state.ready.end());
+    state.gated.clear();
+    for (auto const& fb : m_fbs) {
+        state.gated.push_back(fb.gated);
+    }
+
+    for (auto const& fb : m_fbs) {
+        fb.start();
+    }
+    Vector<char> fb_done(m_fbs.size(), 0);
+    int nfb_done = 0;
+    const auto nfbs = static_cast<int>(m_fbs.size());
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+    {
+        const bool master = OpenMP::get_thread_num() == 0;
+        while (true) {
+            if (master && nfb_done < nfbs) {
+                poll_fillboundary(fb_done, nfb_done);
+            }
+            const int task = pop();
+            if (task >= 0) {
+                run_task(task);
+            } else if (state.ndone.load(std::memory_order_acquire) == ntasks) {
+                if (!master || nfb_done == nfbs) { break; }
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,95 @@
+#include <AMReX_TilePipeline.H>
+#include <AMReX_BLProfiler.H>
+#include <AMReX_FArrayBox.H>
+
+namespace amrex {
+
+int
+TilePipeline::addStage (int ncomp, const IntVect& width, StageFunction f, IndexType typ)
+{
+    AMREX_ALWAYS_ASSERT(ncomp > 0 && width.min() >= 0);
+    m_stages.push_back(Stage{ncomp, width, std::move(f), typ});
+    return numStages()-1;
+}
+
+IntVect
+TilePipeline::halo (int k) const noexcept
+{
+    IntVect h(0);
+    for (int j = k+1; j < numStages(); ++j) {
+        h += m_stages[j].width;
+    }
+    return h;
+}
+
+IntVect
+TilePipeline::nGrowSource () const noexcept
+{
+    return halo(-1);
+}
+
+void
+TilePipeline::run (MultiFab const& src, MultiFab& dst, const IntVect& tilesize) const
+{
+    BL_PROFILE("TilePipeline::run()");
+
+    const int nstages = numStages();
+    if (nstages == 0) { return; }
+
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(src.nGrowVect().allGE(nGrowSource()),
+                                     "TilePipeline::run: not enough ghost cells in src");
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_stages.back().typ == dst.ixType(),
+                                     "TilePipeline::run: the last stage must have the index type of dst");
+    AMREX_ALWAYS_ASSERT(isMFIterSafe(src, dst));
+
+    Vector<IntVect> halos(nstages);
+    for (int k = 0; k < nstages; ++k) {
+        halos[k] = halo(k);
+    }
+
+    MFItInfo info;
+    if (TilingIfNotGPU()) {
+        info.EnableTiling(tilesize);
+    }
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    {
+        StageData d;
+        d.m_outputs.resize(nstages);
+        Vector<FArrayBox> tmps(nstages-1);
+
+        for (MFIter mfi(dst, info); mfi.isValid(); ++mfi)
+        {
+            d.m_src = src.const_array(mfi);
+            d.m_mfi = &mfi;
+            const Box& cbx = mfi.tilebox(IntVect::TheCellVector());
+
+            for (int k = 0; k < nstages; ++k) {
+                auto const& stage = m_stages[k];
+                Box bx;
+                if (k < nstages-1) {
+                    bx = amrex::convert(amrex::grow(cbx, halos[k]), stage.typ);
+                    tmps[k].resize(bx, stage.ncomp, The_Bump_Arena());
+                    d.m_out = tmps[k].array();
+                } else {
+                    bx = mfi.tilebox();
+                    d.m_out = dst.array(mfi);
+                }
+                d.m_stage = k;
+                stage.f(bx, d);
+                if (k < nstages-1) {
+                    d.m_outputs[k] = tmps[k].const_array();
+                }
+            }
+
+            // In reverse order, so that the bump arena reuses the memory for the next tile.
+            for (int k = nstages-2; k >= 0; --k) {
+                tmps[k].clear();
+            }
+        }
+    }
+}
+
+}
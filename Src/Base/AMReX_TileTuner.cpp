@@ -0,0 +1,181 @@
+#include <AMReX_TileTuner.H>
+#include <AMReX_FabArrayBase.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <utility>
+
+namespace amrex::TileTuner {
+
+namespace {
+    bool initialized = false;
+    bool enabled = true;
+    int ntrials = 3;
+    std::string tuner_file;
+
+    struct Entry
+    {
+        Vector<IntVect> candidates;
+        Vector<double> best_time; // per cell
+        int ncalls = 0;
+        bool locked = false;
+        IntVect tilesize;
+    };
+
+    using Key = std::pair<std::string,IntVect>;
+
+    std::map<Key,Entry> entries;
+    std::mutex tuner_mutex;
+
+    Entry& get_entry (std::string const& label, IntVect const& shape)
+    {
+        auto& e = entries[Key(label,shape)];
+        if (e.candidates.empty() && !e.locked) {
+            e.candidates = Candidates(shape);
+            e.best_time.resize(e.candidates.size(), std::numeric_limits<double>::max());
+        }
+        return e;
+    }
+
+    void read_file ()
+    {
+        Vector<char> buf;
+        ParallelDescriptor::ReadAndBcastFile(tuner_file, buf, false);
+        if (buf.empty()) { return; }
+        std::istringstream is(std::string(buf.dataPtr()));
+        std::string label;
+        while (is >> std::quoted(label)) {
+            IntVect shape, tilesize;
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) { is >> shape[d]; }
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) { is >> tilesize[d]; }
+            if (!is) { break; }
+            auto& e = entries[Key(label,shape)];
+            e.locked = true;
+            e.tilesize = tilesize;
+        }
+    }
+
+    void write_file ()
+    {
+        std::ofstream ofs(tuner_file);
+        if (!ofs) {
+            amrex::Warning("TileTuner: cannot open " + tuner_file);
+            return;
+        }
+        for (auto const& [key, e] : entries) {
+            if (!e.locked) { continue; }
+            ofs << std::quoted(key.first);
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) { ofs << " " << key.second[d]; }
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) { ofs << " " << e.tilesize[d]; }
+            ofs << "\n";
+        }
+    }
+}
+
+void
+Initialize ()
+{
+    if (initialized) { return; }
+    initialized = true;
+
+    ParmParse pp("fabarray");
+    pp.queryAdd("tile_tuner", enabled);
+    pp.queryAdd("tile_tuner_trials", ntrials);
+    pp.queryAdd("tile_tuner_file", tuner_file);
+    ntrials = std::max(ntrials, 1);
+
+    if (enabled && !tuner_file.empty()) {
+        read_file();
+    }
+}
+
+void
+Finalize ()
+{
+    if (enabled && !tuner_file.empty() && ParallelDescriptor::IOProcessor()) {
+        write_file();
+    }
+    entries.clear();
+    initialized = false;
+}
+
+bool
+Enabled () noexcept
+{
+    return enabled;
+}
+
+Vector<IntVect>
+Candidates (IntVect const& shape)
+{
+    const IntVect& ts = FabArrayBase::mfiter_tile_size;
+#if (AMREX_SPACEDIM == 3)
+    Vector<IntVect> r{ts, IntVect(ts[0],4,4), IntVect(ts[0],16,16), IntVect(ts[0],32,32),
+                      IntVect(64,8,8), IntVect(128,16,8), IntVect(32,32,32)};
+#elif (AMREX_SPACEDIM == 2)
+    Vector<IntVect> r{ts, IntVect(ts[0],4), IntVect(ts[0],16), IntVect(ts[0],32),
+                      IntVect(64,16), IntVect(128,32)};
+#else
+    Vector<IntVect> r{ts, IntVect(4096), IntVect(1024), IntVect(256)};
+#endif
+    // Tiles larger than the box are the same as the box.
+    for (auto& iv : r) {
+        iv.min(shape);
+    }
+    Vector<IntVect> unique;
+    for (auto const& iv : r) {
+        if (std::find(unique.begin(), unique.end(), iv) == unique.end()) {
+            unique.push_back(iv);
+        }
+    }
+    return unique;
+}
+
+IntVect
+TileSize (std::string const& label, IntVect const& shape)
+{
+    std::lock_guard<std::mutex> lock(tuner_mutex);
+    auto& e = get_entry(label, shape);
+    if (e.locked) {
+        return e.tilesize;
+    } else {
+        return e.candidates[e.ncalls % e.candidates.size()];
+    }
+}
+
+void
+Record (std::string const& label, IntVect const& shape,
+        IntVect const& tilesize, double seconds, Long ncells)
+{
+    if (ncells <= 0) { return; }
+
+    std::lock_guard<std::mutex> lock(tuner_mutex);
+    auto& e = get_entry(label, shape);
+    if (e.locked) { return; }
+
+    const auto ncand = static_cast<int>(e.candidates.size());
+    const int i = e.ncalls % ncand;
+    if (e.candidates[i] != tilesize) { return; } // not the tile size we asked for
+    e.best_time[i] = std::min(e.best_time[i], seconds/double(ncells));
+
+    if (++e.ncalls == ncand*ntrials) {
+        auto ibest = std::distance(e.best_time.begin(),
+                                   std::min_element(e.best_time.begin(), e.best_time.end()));
+        e.tilesize = e.candidates[ibest];
+        e.locked = true;
+        if (amrex::Verbose() > 1) {
+            amrex::Print() << "TileTuner: " << label << " on " << shape
+                           << " boxes uses tile size " << e.tilesize << "\n";
+        }
+    }
+}
+
+}
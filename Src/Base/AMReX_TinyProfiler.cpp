@@ -42,6 +42,7 @@ std::vector<TinyProfiler::aligned_deque> TinyProfiler::mem_stack_thread_private;
 #endif
 std::vector<std::map<std::string, MemStat>*> TinyProfiler::all_memstats;
 std::vector<std::string> TinyProfiler::all_memnames;
+std::vector<std::pair<std::string,std::function<TinyProfiler::CounterList()>>> TinyProfiler::all_counters;
 
 std::vector<std::string>          TinyProfiler::regionstack;
 std::deque<std::tuple<double,double,std::string*> > TinyProfiler::ttstack;
@@ -306,6 +307,23 @@ TinyProfiler::memory_free (std::size_t nbytes, MemStat* stat) noexcept
     }
 }
 
+std::string const&
+TinyProfiler::CurrentFunction () noexcept
+{
+    static const std::string unprofiled("Unprofiled");
+#ifdef AMREX_USE_OMP
+    if (omp_in_parallel() && !mem_stack_thread_private.empty() &&
+        !mem_stack_thread_private[omp_get_thread_num()].deque.empty()) {
+        return mem_stack_thread_private[omp_get_thread_num()].deque.back()->fname;
+    }
+#endif
+    if (!mem_stack.empty()) {
+        return mem_stack.back()->fname;
+    } else {
+        return unprofiled;
+    }
+}
+
 
 void
 TinyProfiler::Initialize () noexcept
@@ -436,10 +454,13 @@ TinyProfiler::Finalize (bool bFlushing) noexcept
         }
     }
 
+    PrintCounters(os);
+
     if (!bFlushing) {
         regionstack.clear();
         ttstack.clear();
         statsmap.clear();
+        all_counters.clear();
     }
 }
 
@@ -901,6 +922,92 @@ TinyProfiler::PrintMemStats (std::map<std::string, MemStat>& memstats,
     *os << hline << "\n\n";
 }
 
+void
+TinyProfiler::RegisterCounters (const std::string& group_name,
+                                std::function<CounterList()> f) noexcept
+{
+    for (auto& [name, func] : all_counters) {
+        if (name == group_name) {
+            func = std::move(f);
+            return;
+        }
+    }
+    all_counters.emplace_back(group_name, std::move(f));
+}
+
+void
+TinyProfiler::PrintCounters (std::ostream* os)
+{
+    const int nprocs = ParallelDescriptor::NProcs();
+    const int ioproc = ParallelDescriptor::IOProcessorNumber();
+
+    for (auto const& [group_name, f] : all_counters)
+    {
+        CounterList counters = f();
+        const auto n = static_cast<int>(counters.size());
+        if (n == 0) { continue; }
+
+        std::vector<Long> vmin(n), vavg(n), vmax(n);
+        for (int i = 0; i < n; ++i) {
+            vmin[i] = vavg[i] = vmax[i] = counters[i].second;
+        }
+        ParallelReduce::Min(vmin.data(), n, ioproc, ParallelDescriptor::Communicator());
+        ParallelReduce::Sum(vavg.data(), n, ioproc, ParallelDescriptor::Communicator());
+        ParallelReduce::Max(vmax.data(), n, ioproc, ParallelDescriptor::Communicator());
+
+        if (!os) { continue; }
+
+        std::vector<std::vector<std::string>> allstatsstr;
+        if (nprocs == 1) {
+            allstatsstr.push_back({"Counter", "Value"});
+        } else {
+            allstatsstr.push_back({"Counter", "Min", "Avg", "Max"});
+        }
+        for (int i = 0; i < n; ++i) {
+            if (nprocs == 1) {
+                allstatsstr.push_back({counters[i].first, std::to_string(vmax[i])});
+            } else {
+                allstatsstr.push_back({counters[i].first, std::to_string(vmin[i]),
+                                       std::to_string(vavg[i]/nprocs),
+                                       std::to_string(vmax[i])});
+            }
+        }
+
+        std::vector<int> maxlen(allstatsstr[0].size(), 0);
+        for (auto& strvec : allstatsstr) {
+            for (std::size_t i=0; i<maxlen.size(); ++i) {
+                maxlen[i] = std::max(maxlen[i], static_cast<int>(strvec[i].size()));
+            }
+        }
+        for (std::size_t i=1; i<maxlen.size(); ++i) {
+            maxlen[i] += 2;
+        }
+
+        IOFormatSaver iofmtsaver(*os);
+        *os << std::setfill(' ');
+
+        int lenhline = 0;
+        for (auto i : maxlen) {
+            lenhline += i;
+        }
+        const std::string hline(lenhline, '-');
+
+        *os << "\n" << group_name << " Counters:\n";
+        *os << hline << "\n";
+        for (std::size_t i=0; i<allstatsstr.size(); ++i) {
+            *os << std::left << std::setw(maxlen[0]) << allstatsstr[i][0];
+            for (std::size_t j=1; j<maxlen.size(); ++j) {
+                *os << std::right << std::setw(maxlen[j]) << allstatsstr[i][j];
+            }
+            *os << '\n';
+            if (i==0) {
+                *os << hline << "\n";
+            }
+        }
+        *os << hline << "\n";
+    }
+}
+
 void
 TinyProfiler::StartRegion (std::string regname) noexcept
 {
@@ -7,6 +7,7 @@
 #include <AMReX_BCRec.H>
 #include <AMReX_EB_Redistribution.H>
 #include <AMReX_EB_utils.H>
+#include <AMReX_BumpArena.H>
 
 namespace amrex {
 
@@ -112,27 +113,28 @@ ApplyMLRedistribution ( Box const& bx, int ncomp,
         Box const& bxg4 = grow(bx,4);
         Box const& bxg5 = grow(bx,5);
 
+        ArenaScope scratch_scope;
 #if (AMREX_SPACEDIM == 2)
         // We assume that in 2D a cell will only need at most 3 neighbors to merge with, and we
         //    use the first component of this for the number of neighbors
 
         // itracker(i,j,n) holds the identifier for (r,s), the nth neighbor of (i,j)
-        IArrayBox itracker(bxg5,4,The_Async_Arena());
+        IArrayBox itracker(bxg5,4,The_Bump_Arena());
 #else
         // We assume that in 3D a cell will only need at most 7 neighbors to merge with, and we
         //    use the first component of this for the number of neighbors
 
         // itracker(i,j,k,n) holds the identifier for (r,s,t), the nth neighbor of (i,j,k)
-        IArrayBox itracker(bxg5,8,The_Async_Arena());
+        IArrayBox itracker(bxg5,8,The_Bump_Arena());
 #endif
-        FArrayBox nrs_fab(bxg5,1,The_Async_Arena());
-        FArrayBox alpha_fab(bxg4,2,The_Async_Arena());
+        FArrayBox nrs_fab(bxg5,1,The_Bump_Arena());
+        FArrayBox alpha_fab(bxg4,2,The_Bump_Arena());
 
         // Total volume of all cells in my nbhd
-        FArrayBox nbhd_vol_fab(bxg3,1,The_Async_Arena());
+        FArrayBox nbhd_vol_fab(bxg3,1,The_Bump_Arena());
 
         // Centroid of my nbhd
-        FArrayBox cent_hat_fab(bxg3,AMREX_SPACEDIM,The_Async_Arena());
+        FArrayBox cent_hat_fab(bxg3,AMREX_SPACEDIM,The_Bump_Arena());
 
         Array4<int> itr = itracker.array();
         Array4<int const> itr_const = itracker.const_array();
@@ -258,27 +260,28 @@ ApplyInitialRedistribution ( Box const& bx, int ncomp,
     Box const& bxg4 = grow(bx,4);
     Box const& bxg5 = grow(bx,5);
 
+    ArenaScope scratch_scope;
 #if (AMREX_SPACEDIM == 2)
         // We assume that in 2D a cell will only need at most 3 neighbors to merge with, and we
         //    use the first component of this for the number of neighbors
 
         // itracker(i,j,n) holds the identifier for (r,s), the nth neighbor of (i,j)
-        IArrayBox itracker(bxg5,4,The_Async_Arena());
+        IArrayBox itracker(bxg5,4,The_Bump_Arena());
 #else
         // We assume that in 3D a cell will only need at most 7 neighbors to merge with, and we
         //    use the first component of this for the number of neighbors
 
         // itracker(i,j,k,n) holds the identifier for (r,s,t), the nth neighbor of (i,j,k)
-        IArrayBox itracker(bxg5,8,The_Async_Arena());
+        IArrayBox itracker(bxg5,8,The_Bump_Arena());
 #endif
-    FArrayBox nrs_fab(bxg5,1,The_Async_Arena());
-    FArrayBox alpha_fab(bxg4,2,The_Async_Arena());
+    FArrayBox nrs_fab(bxg5,1,The_Bump_Arena());
+    FArrayBox alpha_fab(bxg4,2,The_Bump_Arena());
 
     // Total volume of all cells in my nbhd
-    FArrayBox nbhd_vol_fab(bxg3,1,The_Async_Arena());
+    FArrayBox nbhd_vol_fab(bxg3,1,The_Bump_Arena());
 
     // Centroid of my nbhd
-    FArrayBox cent_hat_fab(bxg3,AMREX_SPACEDIM,The_Async_Arena());
+    FArrayBox cent_hat_fab(bxg3,AMREX_SPACEDIM,The_Bump_Arena());
 
     Array4<int> itr = itracker.array();
     Array4<int const> itr_const = itracker.const_array();
@@ -6,6 +6,7 @@
 #include <AMReX_EB_StateRedistSlopeLimiter_K.H>
 #include <AMReX_EB_Slopes_K.H>
 #include <AMReX_YAFluxRegister_K.H>
+#include <AMReX_BumpArena.H>
 
 namespace amrex {
 
@@ -94,14 +95,15 @@ MLStateRedistribute ( Box const& bx, int ncomp,
     if (is_periodic_z) { domain_per_grown.grow(2,2); }
 #endif
 
+    ArenaScope scratch_scope;
     // Solution at the centroid of my nbhd
-    FArrayBox    Qhat_fab (bxg3,ncomp,The_Async_Arena());
+    FArrayBox    Qhat_fab (bxg3,ncomp,The_Bump_Arena());
     Array4<Real> Qhat = Qhat_fab.array();
 
 #if (AMREX_SPACEDIM == 2)
-    FArrayBox qtracker_fab (bxg3,4,The_Async_Arena());
+    FArrayBox qtracker_fab (bxg3,4,The_Bump_Arena());
 #elif (AMREX_SPACEDIM == 3)
-    FArrayBox qtracker_fab (bxg3,8,The_Async_Arena());
+    FArrayBox qtracker_fab (bxg3,8,The_Bump_Arena());
 #endif
     Array4<Real> qt = qtracker_fab.array();
 
@@ -433,8 +435,9 @@ StateRedistribute ( Box const& bx, int ncomp,
     if (is_periodic_z) { domain_per_grown.grow(2,2); }
 #endif
 
+    ArenaScope scratch_scope;
     // Solution at the centroid of my nbhd
-    FArrayBox    Qhat_fab (bxg3,ncomp,The_Async_Arena());
+    FArrayBox    Qhat_fab (bxg3,ncomp,The_Bump_Arena());
     Array4<Real> Qhat = Qhat_fab.array();
 
     // Define Qhat (from Berger and Guliani)
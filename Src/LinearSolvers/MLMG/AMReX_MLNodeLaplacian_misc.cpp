@@ -1,6 +1,7 @@
 #include <AMReX_MLNodeLaplacian.H>
 #include <AMReX_MLNodeLap_K.H>
 #include <AMReX_MultiFabUtil.H>
+#include <AMReX_BumpArena.H>
 
 #ifdef AMREX_USE_EB
 #include <AMReX_EBMultiFabUtil.H>
@@ -563,7 +564,8 @@ MLNodeLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
     }
     else
     {
-        MultiFab Ax(sol.boxArray(), sol.DistributionMap(), 1, 0);
+        ArenaScope scratch_scope;
+        MultiFab Ax(sol.boxArray(), sol.DistributionMap(), 1, 0, MFInfo().SetScratch());
         Fapply(amrlev, mglev, Ax, sol);
 
 #ifdef AMREX_USE_GPU
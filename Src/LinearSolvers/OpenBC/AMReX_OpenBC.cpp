@@ -1,6 +1,7 @@
 #include <AMReX_OpenBC.H>
 #include <AMReX_OpenBC_K.H>
 #include <AMReX_Algorithm.H>
+#include <AMReX_BumpArena.H>
 
 namespace amrex
 {
@@ -806,7 +807,8 @@ void OpenBCSolver::interpolate_potential (MultiFab& solg)
                 if (face.coordDir() == 0) {
                     Box b = amrex::coarsen(b2d,IntVect(crse_ratio,crse_ratio,1));
                     b.grow(1,openbc::P).surroundingNodes(1);
-                    FArrayBox tmpfab(b,1,The_Async_Arena());
+                    ArenaScope scratch_scope;
+                    FArrayBox tmpfab(b,1,The_Bump_Arena());
                     Array4<Real> const& tmp = tmpfab.array();
                     Array4<Real const> const& ctmp = tmpfab.const_array();
                     amrex::ParallelFor(b,
@@ -824,7 +826,8 @@ void OpenBCSolver::interpolate_potential (MultiFab& solg)
                 } else if (face.coordDir() == 1) {
                     Box b = amrex::coarsen(b2d,IntVect(crse_ratio,crse_ratio,1));
                     b.grow(0,openbc::P).surroundingNodes(0);
-                    FArrayBox tmpfab(b,1,The_Async_Arena());
+                    ArenaScope scratch_scope;
+                    FArrayBox tmpfab(b,1,The_Bump_Arena());
                     Array4<Real> const& tmp = tmpfab.array();
                     Array4<Real const> const& ctmp = tmpfab.const_array();
                     amrex::ParallelFor(b,
@@ -842,7 +845,8 @@ void OpenBCSolver::interpolate_potential (MultiFab& solg)
                 } else {
                     Box b = amrex::coarsen(b2d,IntVect(crse_ratio,1,crse_ratio));
                     b.grow(0,openbc::P).surroundingNodes(0);
-                    FArrayBox tmpfab(b,1,The_Async_Arena());
+                    ArenaScope scratch_scope;
+                    FArrayBox tmpfab(b,1,The_Bump_Arena());
                     Array4<Real> const& tmp = tmpfab.array();
                     Array4<Real const> const& ctmp = tmpfab.const_array();
                     amrex::ParallelFor(b,
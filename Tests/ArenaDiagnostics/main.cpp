@@ -0,0 +1,73 @@
+#include <AMReX.H>
+#include <AMReX_CArena.H>
+#include <AMReX_Print.H>
+
+#include <sstream>
+
+using namespace amrex;
+
+namespace {
+
+// The number of blocks in the first row of the table of live allocations
+// at the high-water mark
+int hwm_blocks (CArena const& arena)
+{
+    std::ostringstream os;
+    arena.PrintDiagnostics(os, "Test", "");
+    std::istringstream is(os.str());
+    std::string line;
+    while (std::getline(is, line)) {
+        if (line.find("live allocations at the high-water mark") != std::string::npos) {
+            std::getline(is, line); // header
+            std::getline(is, line);
+            // The region name may have spaces.  The last three columns are
+            // the number of blocks, MB and percent.
+            std::vector<std::string> tokens;
+            std::istringstream ls(line);
+            std::string token;
+            while (ls >> token) { tokens.push_back(token); }
+            AMREX_ALWAYS_ASSERT(tokens.size() >= 4);
+            return std::stoi(tokens[tokens.size()-3]);
+        }
+    }
+    amrex::Abort("No high-water mark table");
+    return -1;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        constexpr std::size_t MB = 1024*1024;
+        CArena arena(64*MB, ArenaInfo().SetDiagnostics());
+
+        std::vector<void*> ps;
+        for (int i = 0; i < 10; ++i) {
+            ps.push_back(arena.alloc(MB));
+        }
+        AMREX_ALWAYS_ASSERT(arena.high_water_mark() == 10*MB);
+        AMREX_ALWAYS_ASSERT(hwm_blocks(arena) == 10);
+        for (auto* p : ps) { arena.free(p); }
+
+        // A new high-water mark, although it is only slightly higher, must
+        // replace the snapshot.
+        void* p = arena.alloc(10*MB + 4096);
+        AMREX_ALWAYS_ASSERT(arena.high_water_mark() == 10*MB + 4096);
+        AMREX_ALWAYS_ASSERT(hwm_blocks(arena) == 1);
+        arena.free(p);
+
+        // Below the high-water mark, the snapshot is unchanged.
+        p = arena.alloc(MB);
+        AMREX_ALWAYS_ASSERT(arena.high_water_mark() == 10*MB + 4096);
+        AMREX_ALWAYS_ASSERT(hwm_blocks(arena) == 1);
+        arena.free(p);
+
+        // This is collective.
+        arena.PrintDiagnostics("Test");
+
+        amrex::Print() << "SUCCESS\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,120 @@
+#include <AMReX.H>
+#include <AMReX_BumpArena.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_MultiFabUtil.H>
+#include <AMReX_OpenMP.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+namespace {
+
+// The stack of the calling thread recycles blocks freed in LIFO order,
+// reclaims blocks freed out of order, and is reset by ArenaScope.
+void test_stack (Arena* arena)
+{
+    void* a = arena->alloc(1000);
+    arena->free(a);
+    void* b = arena->alloc(1000);
+    AMREX_ALWAYS_ASSERT(a == b);
+
+    void* c = arena->alloc(3000);
+    arena->free(b); // not on the top
+    void* d = arena->alloc(500);
+    AMREX_ALWAYS_ASSERT(d != b);
+    arena->free(d);
+    arena->free(c); // pops c and the freed b below it
+    void* e = arena->alloc(2000);
+    AMREX_ALWAYS_ASSERT(e == a);
+
+    {
+        ArenaScope scope(arena);
+        for (int i = 0; i < 10; ++i) {
+            amrex::ignore_unused(arena->alloc(100000));
+        }
+        arena->free(e); // below the mark
+    }
+    void* f = arena->alloc(10);
+    AMREX_ALWAYS_ASSERT(f == a);
+    arena->free(f);
+}
+
+void test_average_down ()
+{
+    const int n_cell = 32;
+    Box cdomain(IntVect(0), IntVect(n_cell-1));
+    Box fdomain = amrex::refine(cdomain, 2);
+
+    BoxArray fba(fdomain);
+    fba.maxSize(16);
+    DistributionMapping fdm(fba);
+    BoxArray cba(cdomain);
+    cba.maxSize(8);
+    DistributionMapping cdm(cba);
+
+    MultiFab fmf(fba, fdm, 2, 0);
+    MultiFab cmf(cba, cdm, 2, 0);
+
+    for (MFIter mfi(fmf); mfi.isValid(); ++mfi) {
+        auto const& a = fmf.array(mfi);
+        amrex::ParallelFor(mfi.validbox(), 2,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k, int n)
+        {
+            a(i,j,k,n) = Real(AMREX_D_TERM(i,+2*j,+4*k) + n) + Real(0.5);
+        });
+    }
+
+    std::size_t bytes = 0;
+    for (int irep = 0; irep < 10; ++irep) {
+        cmf.setVal(0.0);
+        amrex::average_down(fmf, cmf, 0, 2, 2);
+
+        auto const& ma = cmf.const_arrays();
+        Long nerr = ParReduce(TypeList<ReduceOpSum>{}, TypeList<Long>{}, cmf, IntVect(0),
+        [=] AMREX_GPU_DEVICE (int bi, int i, int j, int k) -> GpuTuple<Long>
+        {
+            Long r = 0;
+            for (int n = 0; n < 2; ++n) {
+                Real expected = Real(2*(AMREX_D_TERM(i,+2*j,+4*k)) + n)
+                    + Real(0.5)*Real(AMREX_D_TERM(1,+2,+4)) + Real(0.5);
+                r += Long(std::abs(ma[bi](i,j,k,n) - expected) > Real(1.e-10));
+            }
+            return { r };
+        });
+        ParallelDescriptor::ReduceLongSum(nerr);
+        AMREX_ALWAYS_ASSERT(nerr == 0);
+
+        // The scratch memory is recycled, so the stacks stop growing.
+        if (auto* ba = dynamic_cast<BumpArena*>(The_Bump_Arena())) {
+            if (irep == 0) {
+                bytes = ba->heap_space_used();
+            } else {
+                AMREX_ALWAYS_ASSERT(ba->heap_space_used() == bytes);
+            }
+        }
+    }
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+#ifndef AMREX_USE_GPU
+        AMREX_ALWAYS_ASSERT(dynamic_cast<BumpArena*>(The_Bump_Arena()) != nullptr);
+
+        BumpArena arena(4096);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+        test_stack(&arena);
+#endif
+
+        test_average_down();
+
+        amrex::Print() << "SUCCESS\n";
+    }
+    amrex::Finalize();
+}
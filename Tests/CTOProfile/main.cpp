@@ -0,0 +1,118 @@
+#include <AMReX.H>
+#include <AMReX_BaseFab.H>
+#include <AMReX_CTOProfile.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include <fstream>
+#include <sstream>
+#include <type_traits>
+
+using namespace amrex;
+
+namespace {
+
+constexpr auto hash = detail::cto_label_hash("CTOProfile test");
+
+// cto_profile.H was generated by this test.
+static_assert(std::is_same_v<CTOProfileTable<hash>::type,
+                             TypeList<CTOProfileCase<2,16>, CTOProfileCase<1,8>>>);
+
+// The output of a kernel with ncomp components on a box of length nx
+// in the x-direction is checked, and so is whether the call is
+// specialized by cto_profile.H.
+void run (int ncomp, int nx, bool specialized)
+{
+    const Box bx(IntVect(AMREX_D_DECL(3,-1,0)), IntVect(AMREX_D_DECL(3+nx-1,2,1)));
+    BaseFab<Real> fab(bx, ncomp, The_Pinned_Arena());
+    fab.setVal<RunOn::Device>(Real(1.0));
+    auto const& a = fab.array();
+    auto f = [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+    {
+        a(i,j,k,n) += Real(AMREX_D_TERM(i,+10*j,+100*k) + 1000*n);
+    };
+
+    ParallelForProfiled(AMREX_CTO_SITE("CTOProfile test"), bx, ncomp, f);
+    Gpu::streamSynchronize();
+    for (int n = 0; n < ncomp; ++n) {
+        amrex::LoopOnCpu(bx, [&] (int i, int j, int k)
+        {
+            amrex::ignore_unused(j,k);
+            AMREX_ALWAYS_ASSERT(fab(IntVect(AMREX_D_DECL(i,j,k)),n) ==
+                                Real(1 + AMREX_D_TERM(i,+10*j,+100*k) + 1000*n));
+        });
+    }
+
+    BaseFab<Real> tmp(bx, ncomp);
+    auto const& t = tmp.array();
+    AMREX_ALWAYS_ASSERT(specialized == detail::cto_profile_dispatch(
+        CTOProfileTable<hash>::type{}, bx, ncomp,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept { t(i,j,k,n) = 0; }));
+    Gpu::streamSynchronize();
+}
+
+std::string read_file (std::string const& name)
+{
+    std::ifstream ifs(name);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(ifs.is_open(), ("cannot open " + name).c_str());
+    std::ostringstream os;
+    os << ifs.rdbuf();
+    return os.str();
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+#ifdef AMREX_USE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+
+    auto add_parameters = [] ()
+    {
+        ParmParse pp("amrex");
+        if (!pp.contains("cto_profile_file")) {
+            pp.add("cto_profile_file", std::string("cto_profile_out.H"));
+        }
+    };
+
+    std::string profile_file;
+
+    // A profiling run, whose specializations come from cto_profile.H
+    amrex::Initialize(argc, argv, true, MPI_COMM_WORLD, add_parameters);
+    {
+        AMREX_ALWAYS_ASSERT(CTOProfile::Enabled());
+        ParmParse("amrex").get("cto_profile_file", profile_file);
+
+        for (int i = 0; i < 40; ++i) { run(2, 16, true); }
+        for (int i = 0; i < 10; ++i) { run(1,  8, true); }
+        run(3, 5, false); // too few calls to be in the profile
+        run(2, 8, false);
+        run(1, 16, false);
+    }
+    amrex::Finalize();
+
+    // The profile has the combinations of the table above, and not the
+    // rare ones.
+    amrex::Initialize(argc, argv);
+    {
+        if (ParallelDescriptor::IOProcessor()) {
+            const std::string s = read_file(profile_file);
+            const std::string table = "struct CTOProfileTable<detail::cto_label_hash(\"CTOProfile test\")>";
+            const auto pos = s.find(table);
+            AMREX_ALWAYS_ASSERT(pos != std::string::npos);
+            const auto p0 = s.find("CTOProfileCase<2,16>", pos);
+            const auto p1 = s.find("CTOProfileCase<1,8>", pos);
+            AMREX_ALWAYS_ASSERT(p0 != std::string::npos && p1 != std::string::npos && p0 < p1);
+            AMREX_ALWAYS_ASSERT(s.find("CTOProfileCase<3,5>") == std::string::npos);
+            AMREX_ALWAYS_ASSERT(s.find("CTOProfileCase<2,8>") == std::string::npos);
+            AMREX_ALWAYS_ASSERT(s.find("CTOProfileCase<1,16>") == std::string::npos);
+        }
+        amrex::Print() << "SUCCESS\n";
+    }
+    amrex::Finalize();
+
+#ifdef AMREX_USE_MPI
+    MPI_Finalize();
+#endif
+}
@@ -0,0 +1,137 @@
+#include <AMReX.H>
+#include <AMReX_CommReport.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace amrex;
+
+namespace {
+
+const std::string json_file("comm_report_test.json");
+
+// The per-process values of a member of a call site in the JSON report
+Vector<Long> json_values (std::string const& json, std::string const& site,
+                          std::string const& member)
+{
+    auto pos = json.find("\"name\": \"" + site + "\"");
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(pos != std::string::npos, "Site not found: "+site);
+    pos = json.find("\"" + member + "\": [", pos);
+    AMREX_ALWAYS_ASSERT(pos != std::string::npos);
+    pos = json.find('[', pos) + 1;
+    auto s = json.substr(pos, json.find(']', pos) - pos);
+    for (auto& c : s) {
+        if (c == ',') { c = ' '; }
+    }
+    Vector<Long> r;
+    std::istringstream is(s);
+    Long v;
+    while (is >> v) { r.push_back(v); }
+    return r;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv, true, MPI_COMM_WORLD, [] ()
+    {
+        ParmParse pp("fabarray");
+        pp.add("comm_report", true);
+        pp.add("comm_report_file", json_file);
+    });
+    {
+        AMREX_ALWAYS_ASSERT(CommReport::Enabled());
+
+        const int nprocs = ParallelDescriptor::NProcs();
+        const int ncomp = 2;
+        const int ncalls = 3;
+
+        // Two boxes side by side in the x-direction on processes 0 and 1
+        // (or both on process 0).  Each of them needs one layer of cells
+        // from the other one.
+        const int n_cell = 32;
+        BoxArray ba(Box(IntVect(0), IntVect(n_cell-1)));
+        ba.maxSize(IntVect(AMREX_D_DECL(n_cell/2,n_cell,n_cell)));
+        AMREX_ALWAYS_ASSERT(ba.size() == 2);
+        DistributionMapping dm(Vector<int>{0, std::min(1,nprocs-1)});
+
+        MultiFab mf(ba, dm, ncomp, 1, MFInfo().SetTag("phi"));
+        mf.setVal(1.0);
+        for (int i = 0; i < ncalls; ++i) {
+            mf.FillBoundary();
+        }
+
+        MultiFab mf1(ba, dm, ncomp, 1, MFInfo().SetTag("vec"));
+        MultiFab mf2(ba, dm, ncomp, 1, MFInfo().SetTag("vec"));
+        mf1.setVal(1.0);
+        mf2.setVal(2.0);
+        FillBoundary(Vector<MultiFab*>{&mf1, &mf2});
+
+        // Write the report now, and capture the summary.
+        std::ostringstream summary;
+        auto* cout_buf = std::cout.rdbuf(summary.rdbuf());
+        CommReport::Finalize();
+        std::cout.rdbuf(cout_buf);
+
+        if (ParallelDescriptor::IOProcessor())
+        {
+            std::cout << summary.str();
+            AMREX_ALWAYS_ASSERT(summary.str().find("Communication report") != std::string::npos);
+            AMREX_ALWAYS_ASSERT(summary.str().find("FillBoundary phi") != std::string::npos);
+            AMREX_ALWAYS_ASSERT(summary.str().find("FillBoundary(Vector) vec") != std::string::npos);
+
+            std::ifstream ifs(json_file);
+            AMREX_ALWAYS_ASSERT(ifs.is_open());
+            std::stringstream ss;
+            ss << ifs.rdbuf();
+            const std::string json = ss.str();
+            AMREX_ALWAYS_ASSERT(json.find("\"nprocs\": " + std::to_string(nprocs)) != std::string::npos);
+
+            const Long face_bytes = Long(AMREX_D_TERM(1,*n_cell,*n_cell)) * ncomp * Long(sizeof(Real));
+
+            auto check = [&] (std::string const& site, Long n)
+            {
+                auto calls = json_values(json, site, "ncalls");
+                auto nsend = json_values(json, site, "nsend");
+                auto nrecv = json_values(json, site, "nrecv");
+                auto send_bytes = json_values(json, site, "send_bytes");
+                auto recv_bytes = json_values(json, site, "recv_bytes");
+                auto local_bytes = json_values(json, site, "local_bytes");
+                auto max_neighbors = json_values(json, site, "max_neighbors");
+                AMREX_ALWAYS_ASSERT(int(calls.size()) == nprocs);
+                for (int iproc = 0; iproc < nprocs; ++iproc) {
+                    AMREX_ALWAYS_ASSERT(calls[iproc] == n);
+                    if (nprocs == 1) {
+                        AMREX_ALWAYS_ASSERT(nsend[iproc] == 0 && nrecv[iproc] == 0);
+                        AMREX_ALWAYS_ASSERT(send_bytes[iproc] == 0 && recv_bytes[iproc] == 0);
+                        AMREX_ALWAYS_ASSERT(local_bytes[iproc] == n*2*face_bytes);
+                        AMREX_ALWAYS_ASSERT(max_neighbors[iproc] == 0);
+                    } else if (iproc < 2) {
+                        AMREX_ALWAYS_ASSERT(nsend[iproc] == n && nrecv[iproc] == n);
+                        AMREX_ALWAYS_ASSERT(send_bytes[iproc] == n*face_bytes &&
+                                            recv_bytes[iproc] == n*face_bytes);
+                        AMREX_ALWAYS_ASSERT(local_bytes[iproc] == 0);
+                        AMREX_ALWAYS_ASSERT(max_neighbors[iproc] == 1);
+                    } else {
+                        AMREX_ALWAYS_ASSERT(nsend[iproc] == 0 && nrecv[iproc] == 0);
+                        AMREX_ALWAYS_ASSERT(send_bytes[iproc] == 0 && recv_bytes[iproc] == 0);
+                        AMREX_ALWAYS_ASSERT(local_bytes[iproc] == 0);
+                    }
+                }
+            };
+
+            check("FillBoundary phi", ncalls);
+            check("FillBoundary(Vector) vec", 2);
+
+            std::remove(json_file.c_str());
+        }
+
+        Print() << "SUCCESS\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,101 @@
+#include <AMReX.H>
+#include <AMReX_AmrCore.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_Print.H>
+#include <AMReX_TagBox.H>
+
+using namespace amrex;
+
+namespace {
+
+// Two refined spheres and a refined plane, whose positions depend on the
+// time.  Only the grids are made.
+class MyAmr
+    : public AmrCore
+{
+public:
+    using AmrCore::AmrCore;
+
+    void MakeNewLevelFromScratch (int, Real, const BoxArray&,
+                                  const DistributionMapping&) override {}
+
+    void MakeNewLevelFromCoarse (int, Real, const BoxArray&,
+                                 const DistributionMapping&) override {}
+
+    void RemakeLevel (int, Real, const BoxArray&, const DistributionMapping&) override {}
+
+    void ClearLevel (int) override {}
+
+    void ErrorEst (int lev, TagBoxArray& tags, Real time, int /*ngrow*/) override
+    {
+        const Box domain = Geom(lev).Domain();
+        const Real len = Real(domain.length(0));
+        const Real r0 = Real(0.12) * len;
+        const Real r1 = Real(0.08) * len;
+        const Real c0 = len * (Real(0.25) + Real(0.2)*time);
+        const Real c1 = len * (Real(0.7) - Real(0.1)*time);
+        const int iplane = static_cast<int>(len * (Real(0.5) + Real(0.1)*time));
+        for (MFIter mfi(tags); mfi.isValid(); ++mfi) {
+            auto const& tag = tags.array(mfi);
+            amrex::ParallelFor(mfi.validbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k)
+            {
+                amrex::ignore_unused(k);
+                Real x = Real(i)+Real(0.5);
+                Real y = Real(j)+Real(0.5);
+                Real d0 = AMREX_D_TERM((x-c0)*(x-c0), +(y-c0)*(y-c0),
+                                       +(Real(k)+Real(0.5)-c0)*(Real(k)+Real(0.5)-c0));
+                Real d1 = AMREX_D_TERM((x-c1)*(x-c1), +(y-c0)*(y-c0),
+                                       +(Real(k)+Real(0.5)-c1)*(Real(k)+Real(0.5)-c1));
+                if (d0 < r0*r0 || d1 < r1*r1 || i == iplane) {
+                    tag(i,j,k) = TagBox::SET;
+                }
+            });
+        }
+    }
+};
+
+void test (bool use_new_chop)
+{
+    const int n_cell = 64;
+    Geometry geom(Box(IntVect(0), IntVect(n_cell-1)),
+                  RealBox({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)}),
+                  CoordSys::cartesian, {AMREX_D_DECL(0,0,0)});
+    AmrInfo info;
+    info.max_level = 2;
+    info.max_grid_size = {IntVect(16)};
+    info.blocking_factor = {IntVect(4)};
+    info.grid_eff = Real(0.8);
+    info.use_new_chop = use_new_chop;
+
+    MyAmr amr(geom, info);
+    info.distributed_cluster = true;
+    MyAmr amr_dist(geom, info);
+
+    amr.InitFromScratch(0.0);
+    amr_dist.InitFromScratch(0.0);
+    for (Real time : {Real(0.0), Real(0.5), Real(1.0)}) {
+        if (time > Real(0.0)) {
+            amr.regrid(0, time);
+            amr_dist.regrid(0, time);
+        }
+        AMREX_ALWAYS_ASSERT(amr.finestLevel() == 2);
+        AMREX_ALWAYS_ASSERT(amr_dist.finestLevel() == amr.finestLevel());
+        for (int lev = 1; lev <= amr.finestLevel(); ++lev) {
+            AMREX_ALWAYS_ASSERT(amr_dist.boxArray(lev) == amr.boxArray(lev));
+        }
+    }
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        test(false);
+        test(true);
+
+        amrex::Print() << "SUCCESS\n";
+    }
+    amrex::Finalize();
+}
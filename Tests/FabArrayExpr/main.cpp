@@ -0,0 +1,103 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_OpenMP.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+namespace {
+
+bool close (Real a, Real b)
+{
+    return std::abs(a-b) <= Real(1.e-12) * std::max(std::abs(a), std::abs(b));
+}
+
+void fill (MultiFab& mf, int seed)
+{
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        auto const& a = mf.array(mfi);
+        amrex::ParallelFor(mfi.fabbox(), mf.nComp(),
+        [=] AMREX_GPU_DEVICE (int i, int j, int k, int n)
+        {
+            a(i,j,k,n) = Real((i*7 + j*13 + k*29 + n*3 + seed) % 17) - Real(8.25);
+        });
+    }
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        BoxArray ba(Box(IntVect(0),IntVect(47)));
+        ba.maxSize(16);
+        DistributionMapping dm(ba);
+
+        const int ncomp = 2;
+        const int ng = 1;
+        MultiFab x(ba,dm,ncomp,ng), y(ba,dm,ncomp,ng);
+        MultiFab d1(ba,dm,ncomp,ng), d2(ba,dm,ncomp,ng);
+        fill(x, 1);
+        fill(y, 5);
+
+        const Real a = Real(1.5), b = Real(-0.75);
+
+        // Assignment
+        MultiFab::LinComb(d1, a, x, 0, b, y, 0, 0, ncomp, ng);
+        expr::Assign(d2, 0, ncomp, a*expr::Expr(x) + b*expr::Expr(y), IntVect(ng));
+        MultiFab::Subtract(d2, d1, 0, 0, ncomp, ng);
+        AMREX_ALWAYS_ASSERT(d2.norm0(0, ncomp, IntVect(ng)) == Real(0.0));
+
+        {
+            using namespace amrex::expr;
+            Expr(d2) = Expr(x) * Expr(y) - Expr(x);
+            MultiFab::Copy(d1, x, 0, 0, ncomp, 0);
+            MultiFab::Multiply(d1, y, 0, 0, ncomp, 0);
+            MultiFab::Subtract(d1, x, 0, 0, ncomp, 0);
+            MultiFab::Subtract(d2, d1, 0, 0, ncomp, 0);
+            AMREX_ALWAYS_ASSERT(d2.norm0(0, ncomp, IntVect(0)) == Real(0.0));
+        }
+
+        // Reductions over all components
+        {
+            using namespace amrex::expr;
+
+            Real sum = 0, n0 = 0, n1 = 0, n2 = 0;
+            for (int n = 0; n < ncomp; ++n) {
+                sum += x.sum(n);
+                n0 = std::max(n0, x.norm0(n));
+                n1 += x.norm1(n);
+                n2 += x.norm2(n) * x.norm2(n);
+            }
+            AMREX_ALWAYS_ASSERT(close(Sum(Expr(x)), sum));
+            AMREX_ALWAYS_ASSERT(Norm0(Expr(x)) == n0);
+            AMREX_ALWAYS_ASSERT(close(Norm1(Expr(x)), n1));
+            AMREX_ALWAYS_ASSERT(close(Norm2(Expr(x)), std::sqrt(n2)));
+
+            const Real dot = MultiFab::Dot(x, 0, y, 0, ncomp, ng);
+            AMREX_ALWAYS_ASSERT(close(Dot(Expr(x), Expr(y), IntVect(ng)), dot));
+
+            MultiFab::LinComb(d1, a, x, 0, b, y, 0, 0, ncomp, 0);
+            Real n2lc = 0;
+            for (int n = 0; n < ncomp; ++n) {
+                n2lc += d1.norm2(n) * d1.norm2(n);
+            }
+            AMREX_ALWAYS_ASSERT(close(Norm2(a*Expr(x) + b*Expr(y)), std::sqrt(n2lc)));
+
+            // Local reductions in a parallel region see all the local data.
+            const Real local_dot = MultiFab::Dot(x, 0, y, 0, ncomp, 0, true);
+            int ok = 1;
+#ifdef AMREX_USE_OMP
+#pragma omp parallel reduction(&&:ok)
+#endif
+            {
+                ok = close(Dot(Expr(x), Expr(y), IntVect(0), true), local_dot);
+            }
+            AMREX_ALWAYS_ASSERT(ok);
+        }
+
+        amrex::Print() << "SUCCESS\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,149 @@
+#include <AMReX.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+
+#include <algorithm>
+
+using namespace amrex;
+
+namespace {
+
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+Real f (int i, int j, int k, int n, Box const& domain)
+{
+    // periodic in all directions
+    auto wrap = [] (int x, int lo, int len) { return lo + ((x-lo)%len + len)%len; };
+    AMREX_D_TERM(i = wrap(i, domain.smallEnd(0), domain.length(0));,
+                 j = wrap(j, domain.smallEnd(1), domain.length(1));,
+                 k = wrap(k, domain.smallEnd(2), domain.length(2)););
+    return Real(i + 100*j + 10000*k + 1000000*n);
+}
+
+// Fill the valid cells, call FillBoundary nrep times, and check every cell.
+double test_fb (Geometry const& geom, BoxArray const& ba, DistributionMapping const& dm,
+                int nrep)
+{
+    const int ncomp = 2;
+    const int ng = 2;
+    MultiFab mf(ba, dm, ncomp, ng);
+    const Box domain = geom.Domain();
+
+    mf.setVal(-1.0);
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        auto const& a = mf.array(mfi);
+        amrex::ParallelFor(mfi.validbox(), ncomp,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k, int n)
+        {
+            a(i,j,k,n) = f(i,j,k,n,domain);
+        });
+    }
+
+    double t = ParallelDescriptor::second();
+    for (int irep = 0; irep < nrep; ++irep) {
+        mf.FillBoundary(geom.periodicity());
+    }
+    t = ParallelDescriptor::second() - t;
+    ParallelDescriptor::ReduceRealMax(t);
+
+    auto const& ma = mf.const_arrays();
+    Long nerr = ParReduce(TypeList<ReduceOpSum>{}, TypeList<Long>{}, mf, IntVect(ng), ncomp,
+    [=] AMREX_GPU_DEVICE (int b, int i, int j, int k, int n) -> GpuTuple<Long>
+    {
+        return { Long(ma[b](i,j,k,n) != f(i,j,k,n,domain)) };
+    });
+    ParallelDescriptor::ReduceLongSum(nerr);
+    AMREX_ALWAYS_ASSERT(nerr == 0);
+
+    return t;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    // By default, the processes are split into two groups, each of which
+    // is treated as a node.
+    amrex::Initialize(argc, argv, true, MPI_COMM_WORLD, [] ()
+    {
+        ParmParse pp("fabarray");
+        bool hierarchical = true;
+        pp.queryAdd("fb_hierarchical", hierarchical);
+        int group_size = std::max(ParallelDescriptor::NProcs()/2, 1);
+        pp.queryAdd("fb_hierarchical_group_size", group_size);
+    });
+    {
+        int n_cell = 64;
+        int max_grid_size = 16;
+        int nrep = 10;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("nrep", nrep);
+        }
+
+        Box domain(IntVect(0), IntVect(n_cell-1));
+        Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(1,1,1)};
+        Geometry geom(domain, RealBox(AMREX_D_DECL(Real(0),Real(0),Real(0)),
+                                      AMREX_D_DECL(Real(1),Real(1),Real(1))),
+                      CoordSys::cartesian, is_periodic);
+
+        // The default layout
+        {
+            BoxArray ba(domain);
+            ba.maxSize(max_grid_size);
+            DistributionMapping dm(ba);
+            double t = test_fb(geom, ba, dm, nrep);
+            Print() << "default layout: " << ba.size() << " boxes, "
+                    << nrep << " FillBoundary calls took " << t << " seconds\n";
+        }
+
+        // A ring of slabs along x, where neighboring slabs are on
+        // processes from different halves of the processes.  So there are
+        // no messages within a group.
+        const int nprocs = ParallelDescriptor::NProcs();
+        if (nprocs % 2 == 0)
+        {
+            BoxList bl;
+            const int nx = n_cell / nprocs;
+            Vector<int> pmap;
+            for (int b = 0; b < nprocs; ++b) {
+                Box bx = domain;
+                bx.setSmall(0, b*nx);
+                bx.setBig(0, (b == nprocs-1) ? n_cell-1 : (b+1)*nx-1);
+                bl.push_back(bx);
+                pmap.push_back((b%2 == 0) ? b/2 : nprocs/2 + b/2);
+            }
+            BoxArray ba(std::move(bl));
+            DistributionMapping dm(std::move(pmap));
+            double t = test_fb(geom, ba, dm, nrep);
+            Print() << "slab layout: " << ba.size() << " boxes, "
+                    << nrep << " FillBoundary calls took " << t << " seconds\n";
+        }
+
+        // Slabs along x on 4 processes in two groups of 2, {0,1} and
+        // {2,3}.  There are messages within the first group, but not
+        // within the second.
+        if (nprocs == 4)
+        {
+            BoxList bl;
+            const Vector<int> pmap{0,1,2,0,3,1};
+            const auto nslabs = int(pmap.size());
+            for (int b = 0; b < nslabs; ++b) {
+                Box bx = domain;
+                bx.setSmall(0, b*n_cell/nslabs);
+                bx.setBig(0, (b+1)*n_cell/nslabs-1);
+                bl.push_back(bx);
+            }
+            BoxArray ba(std::move(bl));
+            DistributionMapping dm(pmap);
+            double t = test_fb(geom, ba, dm, nrep);
+            Print() << "asymmetric slab layout: " << ba.size() << " boxes, "
+                    << nrep << " FillBoundary calls took " << t << " seconds\n";
+        }
+
+        Print() << "SUCCESS\n";
+    }
+    amrex::Finalize();
+}
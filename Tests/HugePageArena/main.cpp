@@ -0,0 +1,61 @@
+#include <AMReX.H>
+#include <AMReX_CArena.H>
+#include <AMReX_Print.H>
+
+#include <cstring>
+#include <fstream>
+#include <string>
+
+using namespace amrex;
+
+namespace {
+
+// Whether the kernel may back memory advised with MADV_HUGEPAGE by
+// transparent huge pages
+bool thp_available ()
+{
+#if defined(__linux__)
+    std::ifstream ifs("/sys/kernel/mm/transparent_hugepage/enabled");
+    std::string mode;
+    std::getline(ifs, mode);
+    return mode.find("[always]") != std::string::npos
+        || mode.find("[madvise]") != std::string::npos;
+#else
+    return false;
+#endif
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        constexpr std::size_t MB = 1024*1024;
+        CArena arena(64*MB, ArenaInfo().SetHugePages());
+
+        void* p = arena.alloc(32*MB);
+        std::memset(p, 1, 32*MB);
+
+        const auto used = arena.heap_space_used();
+        const auto huge = arena.heap_space_hugepage_backed();
+        amrex::Print() << "Heap space used: " << used/MB << " MB, backed by huge pages: "
+                       << huge/MB << " MB\n";
+        AMREX_ALWAYS_ASSERT(used >= 64*MB);
+        AMREX_ALWAYS_ASSERT(huge <= used);
+
+        if (thp_available()) {
+            AMREX_ALWAYS_ASSERT(huge > 0);
+        } else {
+            amrex::Print() << "Transparent huge pages are not available. Skipped.\n";
+        }
+
+        arena.free(p);
+        arena.freeUnused();
+        AMREX_ALWAYS_ASSERT(arena.heap_space_used() == 0);
+        AMREX_ALWAYS_ASSERT(arena.heap_space_hugepage_backed() == 0);
+
+        amrex::Print() << "SUCCESS\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,288 @@
+#include <AMReX.H>
+#include <AMReX_AmrCore.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelContext.H>
+#include <AMReX_Print.H>
+#include <AMReX_TagBox.H>
+
+using namespace amrex;
+
+namespace {
+
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+Real f (int lev, int i, int j, int k)
+{
+    return Real(lev*1000000 + AMREX_D_TERM(i,+100*j,+10000*k));
+}
+
+// A refined sphere whose center depends on the time.
+class MyAmr
+    : public AmrCore
+{
+public:
+    using AmrCore::AmrCore;
+
+    Vector<MultiFab> phi = Vector<MultiFab>(2);
+    // Number of boxes that were unchanged by a regrid, and of those
+    // that moved to another process.
+    Long nkept = 0;
+    Long nmoved = 0;
+    // Number of calls to MakeDistributionMap
+    int nmakedm = 0;
+
+    DistributionMapping MakeDistributionMap (int lev, BoxArray const& ba) override
+    {
+        ++nmakedm;
+        return AmrCore::MakeDistributionMap(lev, ba);
+    }
+
+    void MakeNewLevelFromScratch (int lev, Real /*time*/, const BoxArray& ba,
+                                  const DistributionMapping& dm) override
+    {
+        phi[lev].define(ba, dm, 1, 0);
+        fill(lev, phi[lev]);
+    }
+
+    void MakeNewLevelFromCoarse (int lev, Real time, const BoxArray& ba,
+                                 const DistributionMapping& dm) override
+    {
+        MakeNewLevelFromScratch(lev, time, ba, dm);
+    }
+
+    void RemakeLevel (int lev, Real /*time*/, const BoxArray& ba,
+                      const DistributionMapping& dm) override
+    {
+        const BoxArray& old_ba = boxArray(lev);
+        const DistributionMapping& old_dm = DistributionMap(lev);
+        std::vector<std::pair<int,Box>> isects;
+        for (int i = 0; i < static_cast<int>(ba.size()); ++i) {
+            old_ba.intersections(ba[i], isects);
+            for (auto const& is : isects) {
+                if (old_ba[is.first] == ba[i]) {
+                    ++nkept;
+                    nmoved += Long(old_dm[is.first] != dm[i]);
+                }
+            }
+        }
+
+        MultiFab tmp(ba, dm, 1, 0);
+        tmp.setVal(-1.0);
+        tmp.ParallelCopy(phi[lev]);
+        fill(lev, tmp, true);
+        std::swap(tmp, phi[lev]);
+    }
+
+    void ClearLevel (int lev) override
+    {
+        phi[lev].clear();
+    }
+
+    void ErrorEst (int lev, TagBoxArray& tags, Real time, int /*ngrow*/) override
+    {
+        const Box domain = Geom(lev).Domain();
+        const Real r = Real(0.2) * Real(domain.length(0));
+        const Real cx = Real(domain.length(0)) * (Real(0.3) + Real(0.4)*time);
+        const Real cy = Real(domain.length(1)) * Real(0.5);
+#if (AMREX_SPACEDIM == 3)
+        const Real cz = Real(domain.length(2)) * Real(0.5);
+#endif
+        for (MFIter mfi(tags); mfi.isValid(); ++mfi) {
+            auto const& tag = tags.array(mfi);
+            amrex::ParallelFor(mfi.validbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k)
+            {
+                Real d2 = AMREX_D_TERM((Real(i)+Real(0.5)-cx)*(Real(i)+Real(0.5)-cx),
+                                       +(Real(j)+Real(0.5)-cy)*(Real(j)+Real(0.5)-cy),
+                                       +(Real(k)+Real(0.5)-cz)*(Real(k)+Real(0.5)-cz));
+                if (d2 < r*r) { tag(i,j,k) = TagBox::SET; }
+            });
+        }
+    }
+
+    static void fill (int lev, MultiFab& mf, bool only_unset = false)
+    {
+        auto const& ma = mf.arrays();
+        ParallelFor(mf, [=] AMREX_GPU_DEVICE (int b, int i, int j, int k)
+        {
+            if (!only_unset || ma[b](i,j,k) < Real(0.0)) {
+                ma[b](i,j,k) = f(lev,i,j,k);
+            }
+        });
+        Gpu::streamSynchronize();
+    }
+
+    [[nodiscard]] Long check () const
+    {
+        Long nerr = 0;
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            auto const& ma = phi[lev].const_arrays();
+            nerr += ParReduce(TypeList<ReduceOpSum>{}, TypeList<Long>{}, phi[lev], IntVect(0),
+            [=] AMREX_GPU_DEVICE (int b, int i, int j, int k) -> GpuTuple<Long>
+            {
+                return { Long(ma[b](i,j,k) != f(lev,i,j,k)) };
+            });
+        }
+        ParallelDescriptor::ReduceLongSum(nerr);
+        return nerr;
+    }
+};
+
+void test_regrid ()
+{
+    const int n_cell = 64;
+    Geometry geom(Box(IntVect(0), IntVect(n_cell-1)),
+                  RealBox({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)}),
+                  CoordSys::cartesian, {AMREX_D_DECL(0,0,0)});
+    AmrInfo info;
+    info.max_level = 1;
+    info.max_grid_size = {IntVect(16)};
+    info.blocking_factor = {IntVect(8)};
+
+    MyAmr amr(geom, info);
+    info.incremental_regrid = true;
+    info.incremental_regrid_max_imbalance = 0;
+    MyAmr amr_inc(geom, info);
+    AMREX_ALWAYS_ASSERT(!amr.useIncrementalRegrid() && amr_inc.useIncrementalRegrid());
+    // No imbalance is good enough.  So the level is always distributed anew.
+    info.incremental_regrid_max_imbalance = Real(0.5);
+    MyAmr amr_rebal(geom, info);
+
+    amr.InitFromScratch(0.0);
+    amr_inc.InitFromScratch(0.0);
+    amr_rebal.InitFromScratch(0.0);
+    amr_inc.nmakedm = 0;
+    amr_rebal.nmakedm = 0;
+
+    for (Real time : {Real(0.25), Real(0.5), Real(0.5), Real(0.0)}) {
+        amr.regrid(0, time);
+        amr_inc.regrid(0, time);
+        amr_rebal.regrid(0, time);
+        AMREX_ALWAYS_ASSERT(amr.finestLevel() == 1 && amr_inc.finestLevel() == 1 &&
+                            amr_rebal.finestLevel() == 1);
+        AMREX_ALWAYS_ASSERT(amr.boxArray(1) == amr_inc.boxArray(1));
+        AMREX_ALWAYS_ASSERT(amr.boxArray(1) == amr_rebal.boxArray(1));
+        AMREX_ALWAYS_ASSERT(amr.check() == 0);
+        AMREX_ALWAYS_ASSERT(amr_inc.check() == 0);
+        AMREX_ALWAYS_ASSERT(amr_rebal.check() == 0);
+    }
+
+    // The time 0.5 is used twice, so there are three changes.  The new
+    // maps of amr_rebal are made by MakeDistributionMap.  They may still
+    // differ from those of amr, because the mapping prefers the processes
+    // that use the least memory.
+    AMREX_ALWAYS_ASSERT(amr_inc.nmakedm == 0 && amr_rebal.nmakedm == 3);
+
+    // The unchanged boxes did not move.
+    Long nkept = amr_inc.nkept;
+    Long nmoved = amr_inc.nmoved;
+    ParallelDescriptor::ReduceLongSum(nkept);
+    ParallelDescriptor::ReduceLongSum(nmoved);
+    AMREX_ALWAYS_ASSERT(nkept > 0 && nmoved == 0);
+}
+
+// makeIncremental in a sub-communicator whose ranks differ from the
+// global ones.
+void check_incremental (BoxArray const& ba, DistributionMapping const& dm,
+                        BoxArray const& new_ba)
+{
+    const DistributionMapping new_dm = DistributionMapping::makeIncremental(new_ba, ba, dm);
+    AMREX_ALWAYS_ASSERT(new_dm.size() == new_ba.size());
+
+    Vector<int> local(new_dm.size());
+    ParallelContext::global_to_local_rank(local.data(), new_dm.ProcessorMap().data(),
+                                          static_cast<int>(local.size()));
+    for (auto rank : local) {
+        AMREX_ALWAYS_ASSERT(rank >= 0 && rank < ParallelContext::NProcsSub());
+    }
+
+    std::vector<std::pair<int,Box>> isects;
+    for (int i = 0; i < static_cast<int>(new_ba.size()); ++i) {
+        ba.intersections(new_ba[i], isects);
+        for (auto const& is : isects) {
+            if (ba[is.first] == new_ba[i] &&
+                ParallelContext::global_to_local_rank(dm[is.first]) >= 0)
+            {
+                AMREX_ALWAYS_ASSERT(new_dm[i] == dm[is.first]);
+            }
+        }
+    }
+}
+
+// All the boxes are on the first process.  They are kept there unless
+// the imbalance is checked.
+void test_imbalance ()
+{
+    BoxArray ba(Box(IntVect(0), IntVect(63)));
+    ba.maxSize(16);
+    const DistributionMapping dm(Vector<int>(ba.size(), 0));
+
+    auto new_dm = DistributionMapping::makeIncremental(ba, ba, dm);
+    AMREX_ALWAYS_ASSERT(new_dm == dm);
+
+    new_dm = DistributionMapping::makeIncremental(ba, ba, dm, Real(1.5));
+    if (ParallelDescriptor::NProcs() == 1) {
+        AMREX_ALWAYS_ASSERT(new_dm == dm);
+    } else {
+        AMREX_ALWAYS_ASSERT(new_dm.empty());
+    }
+}
+
+void test_subcomm ()
+{
+#ifdef AMREX_USE_MPI
+    const int nprocs = ParallelDescriptor::NProcs();
+    const int myproc = ParallelDescriptor::MyProc();
+    if (nprocs == 1) { return; }
+
+    BoxArray ba(Box(IntVect(0), IntVect(63)));
+    ba.maxSize(16);
+    BoxList bl;
+    for (int i = 0; i < static_cast<int>(ba.size()); ++i) {
+        if (i % 3 == 0) {
+            Box lo = ba[i];
+            Box hi = lo.chop(0, lo.smallEnd(0) + lo.length(0)/2);
+            bl.push_back(lo);
+            bl.push_back(hi);
+        } else {
+            bl.push_back(ba[i]);
+        }
+    }
+    const BoxArray new_ba(std::move(bl));
+
+    // All the processes in the reverse order
+    {
+        const DistributionMapping dm(ba);
+        MPI_Comm comm;
+        MPI_Comm_split(ParallelDescriptor::Communicator(), 0, nprocs-1-myproc, &comm);
+        ParallelContext::push(comm);
+        check_incremental(ba, dm, new_ba);
+        ParallelContext::pop();
+        MPI_Comm_free(&comm);
+    }
+
+    // Half of the processes.  The boxes of the other half are reassigned.
+    {
+        const DistributionMapping dm(ba);
+        MPI_Comm comm;
+        MPI_Comm_split(ParallelDescriptor::Communicator(), int(myproc < nprocs/2), myproc, &comm);
+        ParallelContext::push(comm);
+        check_incremental(ba, dm, new_ba);
+        ParallelContext::pop();
+        MPI_Comm_free(&comm);
+    }
+#endif
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        test_regrid();
+        test_imbalance();
+        test_subcomm();
+
+        amrex::Print() << "SUCCESS\n";
+    }
+    amrex::Finalize();
+}
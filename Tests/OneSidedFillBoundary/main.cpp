@@ -0,0 +1,136 @@
+#include <AMReX.H>
+#include <AMReX_FBWindow.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+
+#include <memory>
+
+using namespace amrex;
+
+namespace {
+
+void fill (MultiFab& mf)
+{
+    mf.setVal(-1.0);
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        auto const& a = mf.array(mfi);
+        amrex::ParallelFor(mfi.validbox(), mf.nComp(),
+        [=] AMREX_GPU_DEVICE (int i, int j, int k, int n)
+        {
+            a(i,j,k,n) = std::sin(Real(0.37)*Real(i) + Real(1.3)*Real(j)
+                                  + Real(2.1)*Real(k) + Real(n));
+        });
+    }
+}
+
+// The number of cells, including ghost cells, in components [scomp,scomp+ncomp)
+// that differ from ref.
+Long ndiff (MultiFab const& mf, MultiFab const& ref, int scomp, int ncomp)
+{
+    auto const& ma = mf.const_arrays();
+    auto const& mr = ref.const_arrays();
+    Long n = ParReduce(TypeList<ReduceOpSum>{}, TypeList<Long>{}, mf, mf.nGrowVect(), ncomp,
+    [=] AMREX_GPU_DEVICE (int b, int i, int j, int k, int n) -> GpuTuple<Long>
+    {
+        return { Long(ma[b](i,j,k,scomp+n) != mr[b](i,j,k,scomp+n)) };
+    });
+    ParallelDescriptor::ReduceLongSum(n);
+    return n;
+}
+
+// The first FillBoundary of a pattern uses the two-sided path.  The
+// following ones use the one-sided path, which must give the same result.
+void test (Geometry const& geom, BoxArray const& ba, DistributionMapping const& dm)
+{
+    const int ncomp = 3;
+    MultiFab mf(ba, dm, ncomp, 2);
+    fill(mf);
+    mf.FillBoundary(geom.periodicity());
+
+    MultiFab ref(ba, dm, ncomp, 2);
+    MultiFab::Copy(ref, mf, 0, 0, ncomp, mf.nGrowVect());
+
+    for (int irep = 0; irep < 4; ++irep) {
+        mf.setBndry(-1.0);
+        if (irep % 2 == 0) {
+            mf.FillBoundary(geom.periodicity());
+        } else {
+            mf.FillBoundary_nowait(geom.periodicity());
+            mf.plus(0.0, 0, ncomp, 0);
+            mf.FillBoundary_finish();
+        }
+        AMREX_ALWAYS_ASSERT(ndiff(mf, ref, 0, ncomp) == 0);
+    }
+
+    // Fewer components than the window was created for
+    mf.setBndry(-1.0);
+    mf.FillBoundary(1, 2, geom.periodicity());
+    AMREX_ALWAYS_ASSERT(ndiff(mf, ref, 1, 2) == 0);
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv, true, MPI_COMM_WORLD, [] ()
+    {
+        ParmParse pp("fabarray");
+        pp.add("fb_rma", 1);
+        pp.add("fb_rma_min_uses", 2);
+    });
+    {
+        AMREX_ALWAYS_ASSERT(FBWindow::Enabled() || ParallelDescriptor::NProcs() == 1);
+
+        const int n_cell = 32;
+        Box domain(IntVect(0), IntVect(n_cell-1));
+        Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(1,1,1)};
+        Geometry geom(domain, RealBox(AMREX_D_DECL(Real(0),Real(0),Real(0)),
+                                      AMREX_D_DECL(Real(1),Real(1),Real(1))),
+                      CoordSys::cartesian, is_periodic);
+
+        BoxArray ba(domain);
+        ba.maxSize(8);
+        DistributionMapping dm(ba);
+        test(geom, ba, dm);
+
+        // Boxes of different sizes, and a process may own neighboring boxes
+        BoxArray ba2(domain);
+        ba2.maxSize(IntVect(AMREX_D_DECL(16,8,32)));
+        Vector<int> pmap(ba2.size());
+        const int nprocs = ParallelDescriptor::NProcs();
+        for (int i = 0; i < ba2.size(); ++i) {
+            pmap[i] = (i/3) % nprocs;
+        }
+        test(geom, ba2, DistributionMapping(std::move(pmap)));
+
+        // Windows are freed collectively, even if the FabArrays are
+        // destroyed in different orders on different processes.
+        {
+            Vector<std::unique_ptr<MultiFab>> mfs;
+            for (int i = 0; i < 4; ++i) {
+                mfs.push_back(std::make_unique<MultiFab>(ba, dm, 1, 1));
+                mfs.back()->setVal(Real(i));
+                mfs.back()->FillBoundary(geom.periodicity());
+                mfs.back()->FillBoundary(geom.periodicity());
+            }
+            const int myproc = ParallelDescriptor::MyProc();
+            for (int i = 0; i < 4; ++i) {
+                mfs[(i+myproc)%4].reset();
+            }
+            // Destroyed on the first process only
+            MultiFab mf(ba, dm, 1, 1);
+            mf.FillBoundary(geom.periodicity());
+            mf.FillBoundary(geom.periodicity());
+            if (myproc == 0) {
+                mf.clear();
+            }
+            // A new window is created after the released ones are freed.
+            test(geom, ba, dm);
+            FBWindow::FreeReleased();
+        }
+
+        Print() << "SUCCESS\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,124 @@
+#include <AMReX.H>
+#include <AMReX_BaseFab.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+namespace {
+
+template <typename T>
+T f (int i, int j, int k, int n)
+{
+    return T((i*7 + j*13 + k*29 + n*31) % 101);
+}
+
+template <typename T>
+void fill (BaseFab<T>& fab, int seed)
+{
+    auto const& a = fab.array();
+    amrex::LoopOnCpu(fab.box(), fab.nComp(), [&] (int i, int j, int k, int n)
+    {
+        a(i,j,k,n) = f<T>(i,j,k,n+seed);
+    });
+}
+
+// Does fab equal g(i,j,k,n) in bx and components [c0,c0+nc), and f
+// shifted by seed elsewhere?
+template <typename T, typename G>
+bool check (BaseFab<T> const& fab, int seed, Box const& bx, int c0, int nc, G const& g)
+{
+    auto const& a = fab.const_array();
+    bool ok = true;
+    amrex::LoopOnCpu(fab.box(), fab.nComp(), [&] (int i, int j, int k, int n)
+    {
+        const T expected = (bx.contains(IntVect(AMREX_D_DECL(i,j,k))) && n >= c0 && n < c0+nc)
+            ? g(i,j,k,n) : f<T>(i,j,k,n+seed);
+        ok = ok && (a(i,j,k,n) == expected);
+    });
+    return ok;
+}
+
+// The threaded (and, for setVal, streaming) operations give the same
+// results as the loops, for whole fabs with contiguous rows and for
+// parts of them at odd offsets.
+template <typename T>
+void test (Box const& domain)
+{
+    const int ncomp = 3;
+    BaseFab<T> src(domain, ncomp);
+    BaseFab<T> dst(domain, ncomp);
+    fill(src, 1);
+
+    const IntVect shift(AMREX_D_DECL(1,2,1));
+    Box sub = amrex::grow(domain, -2);
+    sub.growHi(0, -1);
+
+    for (Box const& bx : {domain, sub}) {
+        const int c0 = (bx == domain) ? 0 : 1;
+        const int nc = ncomp - c0;
+
+        fill(dst, 5);
+        dst.template setVal<RunOn::Host>(T(42), bx, DestComp{c0}, NumComps{nc});
+        AMREX_ALWAYS_ASSERT(check(dst, 5, bx, c0, nc, [] (int, int, int, int) { return T(42); }));
+
+        fill(dst, 5);
+        dst.template copy<RunOn::Host>(src, bx, SrcComp{0}, DestComp{c0}, NumComps{nc});
+        AMREX_ALWAYS_ASSERT(check(dst, 5, bx, c0, nc, [=] (int i, int j, int k, int n)
+            { return f<T>(i,j,k,n-c0+1); }));
+
+        fill(dst, 5);
+        dst.template plus<RunOn::Host>(src, bx, SrcComp{0}, DestComp{c0}, NumComps{nc});
+        AMREX_ALWAYS_ASSERT(check(dst, 5, bx, c0, nc, [=] (int i, int j, int k, int n)
+            { return f<T>(i,j,k,n+5) + f<T>(i,j,k,n-c0+1); }));
+
+        fill(dst, 5);
+        dst.template plus<RunOn::Host>(T(3), bx, DestComp{c0}, NumComps{nc});
+        AMREX_ALWAYS_ASSERT(check(dst, 5, bx, c0, nc, [] (int i, int j, int k, int n)
+            { return f<T>(i,j,k,n+5) + T(3); }));
+    }
+
+    // copy and plus from a shifted source box
+    const Box dbx = amrex::grow(domain, -2);
+    const Dim3 s = shift.dim3();
+    fill(dst, 5);
+    dst.template copy<RunOn::Host>(src, dbx+shift, 1, dbx, 0, 2);
+    AMREX_ALWAYS_ASSERT(check(dst, 5, dbx, 0, 2, [=] (int i, int j, int k, int n)
+        { return f<T>(i+s.x, j+s.y, k+s.z, n+2); }));
+
+    fill(dst, 5);
+    dst.template plus<RunOn::Host>(src, dbx+shift, dbx, 1, 0, 2);
+    AMREX_ALWAYS_ASSERT(check(dst, 5, dbx, 0, 2, [=] (int i, int j, int k, int n)
+        { return f<T>(i,j,k,n+5) + f<T>(i+s.x, j+s.y, k+s.z, n+2); }));
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        const Box domain(IntVect(AMREX_D_DECL(-3,0,2)), IntVect(AMREX_D_DECL(36,28,20)));
+
+        // Not threaded by default
+        AMREX_ALWAYS_ASSERT(!basefab_use_omp);
+        test<Real>(domain);
+
+        // The default thresholds, which are above the size of the fab
+        basefab_use_omp = true;
+        test<Real>(domain);
+
+        // Every operation is threaded, and setVal streams.
+        basefab_omp_min_size = 1;
+        basefab_nontemporal_min_bytes = 1;
+        test<Real>(domain);
+        test<int>(domain);
+        test<Real>(Box(IntVect(0), IntVect(AMREX_D_DECL(4,3,2))));
+
+        // Switched off
+        basefab_use_omp = false;
+        test<Real>(domain);
+
+        amrex::Print() << "SUCCESS\n";
+    }
+    amrex::Finalize();
+}
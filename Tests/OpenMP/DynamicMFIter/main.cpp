@@ -0,0 +1,69 @@
+#include <AMReX.H>
+#include <AMReX_iMultiFab.H>
+#include <AMReX_OpenMP.H>
+#include <AMReX_Print.H>
+
+#include <atomic>
+
+using namespace amrex;
+
+namespace {
+
+// Every cell of every tile is visited by exactly one thread.  The cost of
+// a tile depends on its position, so that the threads run out of their own
+// tiles at different times and steal.
+void test (iMultiFab& count, IntVect const& tilesize, int nrep)
+{
+    count.setVal(0);
+
+    std::atomic<Long> ntiles{0};
+    Long ntiles_static = 0;
+    for (MFIter mfi(count, MFItInfo().EnableTiling(tilesize)); mfi.isValid(); ++mfi) {
+        ++ntiles_static;
+    }
+
+    for (int irep = 0; irep < nrep; ++irep) {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+        for (MFIter mfi(count, MFItInfo().EnableTiling(tilesize).SetDynamic(true));
+             mfi.isValid(); ++mfi)
+        {
+            ++ntiles;
+            Box const& bx = mfi.tilebox();
+            auto const& a = count.array(mfi);
+            const int work = (bx.smallEnd(0) % 3 == 0) ? 200 : 1;
+            for (int iwork = 0; iwork < work; ++iwork) {
+                amrex::LoopOnCpu(bx, [&] (int i, int j, int k)
+                {
+                    if (iwork == 0) { ++a(i,j,k); }
+                });
+            }
+        }
+    }
+
+    AMREX_ALWAYS_ASSERT(ntiles.load() == ntiles_static*nrep);
+    AMREX_ALWAYS_ASSERT(count.min(0) == nrep);
+    AMREX_ALWAYS_ASSERT(count.max(0) == nrep);
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        BoxArray ba(Box(IntVect(0), IntVect(63)));
+        ba.maxSize(32);
+        DistributionMapping dm(ba);
+        iMultiFab count(ba, dm, 1, 0);
+
+        // Fewer tiles than threads, and many tiles per thread
+        test(count, IntVect(32), 3);
+        test(count, IntVect(AMREX_D_DECL(1024,4,4)), 3);
+        test(count, IntVect(AMREX_D_DECL(1024,1,1)), 2);
+
+        amrex::Print() << "SUCCESS\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,100 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_NumaArena.H>
+#include <AMReX_OpenMP.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+namespace {
+
+// The pools that have served requests
+Vector<int> used_pools (NumaArena const& arena)
+{
+    Vector<int> r;
+    for (int node = 0; node < NumaArena::NumNodes(); ++node) {
+        r.push_back(int(arena.heap_space_used(node) > 0));
+    }
+    r.push_back(int(arena.heap_space_used(ArenaInfo::NumaInterleave) > 0));
+    return r;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        const int nnodes = NumaArena::NumNodes();
+        AMREX_ALWAYS_ASSERT(nnodes >= 1);
+        for (int tid = 0; tid < OpenMP::get_max_threads(); ++tid) {
+            const int node = NumaArena::ThreadNode(tid);
+            AMREX_ALWAYS_ASSERT(node >= 0 && node < nnodes);
+        }
+
+        // Outside parallel regions
+        {
+            NumaArena arena(true);
+            void* p = arena.alloc(1000);
+            Vector<int> expected(nnodes+1, 0);
+            expected[nnodes] = 1;
+            AMREX_ALWAYS_ASSERT(used_pools(arena) == expected);
+            arena.free(p);
+        }
+        {
+            NumaArena arena(false);
+            void* p = arena.alloc(1000);
+            AMREX_ALWAYS_ASSERT(used_pools(arena)[nnodes] == 0);
+            arena.free(p);
+        }
+
+        // In a NodeScope
+        {
+            NumaArena arena(true);
+            Vector<void*> ps;
+            for (int node = 0; node < nnodes; ++node) {
+                NumaArena::NodeScope scope(node);
+                ps.push_back(arena.alloc(1000));
+            }
+            Vector<int> expected(nnodes+1, 1);
+            expected[nnodes] = 0;
+            AMREX_ALWAYS_ASSERT(used_pools(arena) == expected);
+            for (auto* p : ps) { arena.free(p); }
+        }
+
+        // Inside a parallel region
+        {
+            NumaArena arena(true);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+            {
+                void* p = arena.alloc(1000);
+                arena.free(p);
+            }
+            AMREX_ALWAYS_ASSERT(used_pools(arena)[nnodes] == 0);
+        }
+
+        // The data of a FAB are on the node of the thread that owns it.
+        {
+            NumaArena arena(true);
+            BoxArray ba(Box(IntVect(0), IntVect(63)));
+            ba.maxSize(16);
+            DistributionMapping dm(ba);
+            MultiFab mf(ba, dm, 1, 0, MFInfo().SetArena(&arena));
+
+            Vector<int> expected(nnodes+1, 0);
+            const int n = mf.local_size();
+            for (int i = 0; i < n; ++i) {
+                expected[NumaArena::OwnerNode(i, n)] = 1;
+            }
+            AMREX_ALWAYS_ASSERT(used_pools(arena) == expected);
+
+            mf.setVal(1.0);
+            AMREX_ALWAYS_ASSERT(mf.sum(0) == Real(ba.numPts()));
+        }
+
+        amrex::Print() << "SUCCESS\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,104 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_OpenMP.H>
+#include <AMReX_Print.H>
+#include <AMReX_ThreadPool.H>
+
+using namespace amrex;
+
+namespace {
+
+struct Result
+{
+    Real sum, dot, max, min, norm1;
+    Long ncells;
+
+    bool operator== (Result const& rhs) const {
+        return sum == rhs.sum && dot == rhs.dot && max == rhs.max && min == rhs.min
+            && norm1 == rhs.norm1 && ncells == rhs.ncells;
+    }
+};
+
+// Local reductions, which may be called in a parallel region.
+Result reduce (MultiFab const& mf)
+{
+    Result r{};
+    r.sum = mf.sum(0, true);
+    r.dot = MultiFab::Dot(mf, 0, mf, 0, 1, 0, true);
+    r.max = mf.max(0, 0, true);
+    r.min = mf.min(0, 0, true);
+    r.norm1 = mf.norm1(0, 0, true);
+    r.ncells = static_cast<Long>(ReduceSum(mf, 0,
+        [=] (Box const& bx, Array4<Real const> const&) -> Real
+        {
+            return static_cast<Real>(bx.numPts());
+        }));
+    return r;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        BoxArray ba(Box(IntVect(0),IntVect(63)));
+        ba.maxSize(16);
+        DistributionMapping dm(ba);
+
+        MultiFab mf(ba,dm,1,0);
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+            auto const& a = mf.array(mfi);
+            amrex::ParallelFor(mfi.validbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k)
+            {
+                a(i,j,k) = Real(1 + (i+2*j+3*k)%7);
+            });
+        }
+
+        const Result expected = reduce(mf);
+
+        Vector<int> ok(std::max(OpenMP::get_max_threads(), ThreadPool::NumThreads()), 0);
+
+        // Every thread of an existing parallel region gets the full result.
+        int nteam = 1;
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+        {
+            ok[OpenMP::get_thread_num()] = (reduce(mf) == expected);
+            if (OpenMP::get_thread_num() == 0) {
+                nteam = OpenMP::get_num_threads();
+            }
+        }
+        for (int i = 0; i < nteam; ++i) {
+            AMREX_ALWAYS_ASSERT(ok[i]);
+        }
+
+        // So does a single thread of it.
+        int single_ok = 0;
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#pragma omp single
+#endif
+        {
+            single_ok = (reduce(mf) == expected);
+        }
+        AMREX_ALWAYS_ASSERT(single_ok);
+
+        // And every thread of a ParallelRegion, which may be a pool task.
+        std::fill(ok.begin(), ok.end(), 0);
+        ParallelRegion([&] ()
+        {
+            ok[OpenMP::get_thread_num()] = (reduce(mf) == expected);
+            if (OpenMP::get_thread_num() == 0) {
+                nteam = OpenMP::get_num_threads();
+            }
+        });
+        for (int i = 0; i < nteam; ++i) {
+            AMREX_ALWAYS_ASSERT(ok[i]);
+        }
+
+        amrex::Print() << "SUCCESS\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,194 @@
+#include <AMReX.H>
+#include <AMReX_CArena.H>
+#include <AMReX_OpenMP.H>
+#include <AMReX_Print.H>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace amrex;
+
+namespace {
+
+constexpr std::size_t MB = 1024*1024;
+
+struct Block
+{
+    void* p = nullptr;
+    std::size_t nbytes = 0;
+    unsigned char value = 0;
+};
+
+void fill (Block const& b)
+{
+    std::memset(b.p, b.value, b.nbytes);
+}
+
+bool check (Block const& b)
+{
+    auto const* c = static_cast<unsigned char const*>(b.p);
+    for (std::size_t i = 0; i < b.nbytes; ++i) {
+        if (c[i] != b.value) { return false; }
+    }
+    return true;
+}
+
+// Blocks handed from one thread to another, so that they are freed by a
+// thread other than the one that allocated them.
+class Exchange
+{
+public:
+    void push (Block const& b) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_blocks.push_back(b);
+    }
+    bool pop (Block& b) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_blocks.empty()) { return false; }
+        b = m_blocks.back();
+        m_blocks.pop_back();
+        return true;
+    }
+private:
+    std::mutex m_mutex;
+    std::vector<Block> m_blocks;
+};
+
+// Allocate and free blocks of random sizes, some of them freed by other
+// threads, and check that no block is handed out twice.
+void work (CArena& arena, Exchange& exchange, int seed, int niters, std::atomic<int>& nerrors)
+{
+    std::vector<Block> live;
+    std::uint64_t state = 12345 + seed;
+    auto next = [&] () {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<unsigned>(state >> 33);
+    };
+    for (int i = 0; i < niters; ++i) {
+        const unsigned r = next();
+        if (live.size() < 64 && r % 3 != 0) {
+            Block b;
+            b.nbytes = 8 + next() % 20000;
+            b.p = arena.alloc(b.nbytes);
+            b.value = static_cast<unsigned char>(next());
+            fill(b);
+            if (r % 5 == 0) {
+                exchange.push(b);
+            } else {
+                live.push_back(b);
+            }
+        } else if (!live.empty()) {
+            const std::size_t j = next() % live.size();
+            if (!check(live[j])) { ++nerrors; }
+            arena.free(live[j].p);
+            live[j] = live.back();
+            live.pop_back();
+        }
+        Block b;
+        if (r % 7 == 0 && exchange.pop(b)) {
+            if (!check(b)) { ++nerrors; }
+            arena.free(b.p);
+        }
+        if (r % 997 == 0) {
+            arena.freeUnused();
+        }
+    }
+    for (auto const& b : live) {
+        if (!check(b)) { ++nerrors; }
+        arena.free(b.p);
+    }
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        std::atomic<int> nerrors{0};
+
+        // OpenMP threads and a thread that is not an OpenMP thread use the
+        // same arena, free each other's blocks and free unused memory
+        // concurrently.
+        {
+            CArena arena(4*MB, ArenaInfo().SetThreadCache(256*1024, 32768));
+            Exchange exchange;
+            const int niters = 20000;
+            std::thread other([&] () { work(arena, exchange, -1, niters, nerrors); });
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+            work(arena, exchange, OpenMP::get_thread_num(), niters, nerrors);
+            other.join();
+
+            Block b;
+            while (exchange.pop(b)) {
+                if (!check(b)) { ++nerrors; }
+                arena.free(b.p);
+            }
+            AMREX_ALWAYS_ASSERT(nerrors == 0);
+
+            arena.freeUnused();
+            AMREX_ALWAYS_ASSERT(arena.thread_cache_bytes() == 0);
+            AMREX_ALWAYS_ASSERT(arena.heap_space_actually_used() == 0);
+            AMREX_ALWAYS_ASSERT(arena.heap_space_used() == 0);
+        }
+
+        // More arenas than a thread used to have cache entries for, some of
+        // them created at the addresses of destroyed ones.
+        for (int irep = 0; irep < 3; ++irep) {
+            std::vector<std::unique_ptr<CArena>> arenas;
+            for (int i = 0; i < 20; ++i) {
+                arenas.push_back(std::make_unique<CArena>(MB, ArenaInfo().SetThreadCache(64*1024, 4096)));
+            }
+#ifdef AMREX_USE_OMP
+#pragma omp parallel
+#endif
+            {
+                std::vector<Block> blocks;
+                for (int n = 0; n < 10; ++n) {
+                    for (int i = 0; i < 20; ++i) {
+                        Block b;
+                        b.nbytes = 100 + 50*i;
+                        b.p = arenas[i]->alloc(b.nbytes);
+                        b.value = static_cast<unsigned char>(i + n);
+                        fill(b);
+                        blocks.push_back(b);
+                    }
+                }
+                for (int i = 0; i < int(blocks.size()); ++i) {
+                    if (!check(blocks[i])) { ++nerrors; }
+                    arenas[i%20]->free(blocks[i].p);
+                }
+            }
+            AMREX_ALWAYS_ASSERT(nerrors == 0);
+            for (auto& a : arenas) {
+                a->freeUnused();
+                AMREX_ALWAYS_ASSERT(a->heap_space_actually_used() == 0);
+            }
+        }
+
+        // A block of a thread cache keeps its size class.
+        {
+            CArena arena(MB, ArenaInfo().SetThreadCache(64*1024, 4096));
+            void* p = arena.alloc(1000);
+            auto r = arena.alloc_in_place(p, 1000, 1024);
+            AMREX_ALWAYS_ASSERT(r.first == p && r.second == 1024);
+            r = arena.alloc_in_place(p, 2000, 2000);
+            AMREX_ALWAYS_ASSERT(r.first != p);
+            AMREX_ALWAYS_ASSERT(arena.shrink_in_place(p, 100) == p);
+            arena.free(r.first);
+            arena.free(p);
+            arena.freeUnused();
+            AMREX_ALWAYS_ASSERT(arena.heap_space_actually_used() == 0);
+        }
+
+        amrex::Print() << "SUCCESS\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,103 @@
+#include <AMReX.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_MultiFab.H>
+
+using namespace amrex;
+
+namespace {
+
+void test (Geometry const& geom, BoxArray const& ba, DistributionMapping const& dm)
+{
+    const int ng = 2;
+    MultiFab phi(ba, dm, 1, ng);
+    MultiFab lap_ref(ba, dm, 1, 0);
+    MultiFab lap(ba, dm, 1, 0);
+
+    auto stencil = [=] AMREX_GPU_DEVICE (Array4<Real const> const& a, int i, int j, int k)
+    {
+        Real r = Real(-2*AMREX_SPACEDIM) * a(i,j,k);
+        AMREX_D_TERM(r += a(i-ng,j,k) + a(i+ng,j,k);,
+                     r += a(i,j-ng,k) + a(i,j+ng,k);,
+                     r += a(i,j,k-ng) + a(i,j,k+ng););
+        return r;
+    };
+
+    auto init = [&] ()
+    {
+        phi.setVal(-1.0);
+        for (MFIter mfi(phi); mfi.isValid(); ++mfi) {
+            auto const& a = phi.array(mfi);
+            amrex::ParallelFor(mfi.validbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k)
+            {
+                a(i,j,k) = Real(i + 2*j + 3*k);
+            });
+        }
+    };
+
+    init();
+    phi.FillBoundary(geom.periodicity());
+    for (MFIter mfi(lap_ref); mfi.isValid(); ++mfi) {
+        auto const& a = phi.const_array(mfi);
+        auto const& l = lap_ref.array(mfi);
+        amrex::ParallelFor(mfi.validbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            l(i,j,k) = stencil(a,i,j,k);
+        });
+    }
+
+    init();
+    phi.FillBoundary_nowait(geom.periodicity());
+    Long ntiles = 0;
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion()) reduction(+:ntiles)
+#endif
+    for (MFIter mfi(lap, MFItInfo().EnableTiling(IntVect(8)).OverlapFillBoundary(phi));
+         mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        auto const& a = phi.const_array(mfi);
+        auto const& l = lap.array(mfi);
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            l(i,j,k) = stencil(a,i,j,k);
+        });
+        ++ntiles;
+    }
+
+    AMREX_ALWAYS_ASSERT(ntiles > 0);
+
+    MultiFab::Subtract(lap, lap_ref, 0, 0, 1, 0);
+    Real err = lap.norminf(0);
+    Print() << "max error: " << err << "\n";
+    AMREX_ALWAYS_ASSERT(err == Real(0));
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        Box domain(IntVect(0), IntVect(63));
+        Array<int,AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(1,1,1)};
+        Geometry geom(domain, RealBox(AMREX_D_DECL(Real(0),Real(0),Real(0)),
+                                      AMREX_D_DECL(Real(1),Real(1),Real(1))),
+                      CoordSys::cartesian, is_periodic);
+        BoxArray ba(domain);
+        ba.maxSize(16);
+
+        test(geom, ba, DistributionMapping(ba));
+
+        // Neighboring boxes are on different processes if there is more
+        // than one.
+        const int nprocs = ParallelDescriptor::NProcs();
+        Vector<int> pmap(ba.size());
+        for (int i = 0; i < ba.size(); ++i) {
+            pmap[i] = i % nprocs;
+        }
+        test(geom, ba, DistributionMapping(std::move(pmap)));
+
+        Print() << "SUCCESS\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,105 @@
+#include <AMReX.H>
+#include <AMReX_CArena.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Particles.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+namespace {
+
+using PC = ParticleContainer<0, 0, 2, 1>;
+using PTile = PC::ParticleTileType;
+
+// Resize the tile in small steps, checking that the data are kept.  Return
+// the number of times the capacity has changed.
+int grow (PTile& ptile)
+{
+    int nrealloc = 0;
+    Long capacity = ptile.capacity();
+    for (int np = 1000; np <= 2000; np += 100) {
+        const int np_old = ptile.numParticles();
+        ptile.resize(np);
+        auto& soa = ptile.GetStructOfArrays();
+        auto* rdata = soa.GetRealData(1).dataPtr();
+        auto* idata = soa.GetIntData(0).dataPtr();
+        for (int i = 0; i < np_old; ++i) {
+            AMREX_ALWAYS_ASSERT(rdata[i] == ParticleReal(i) && idata[i] == -i);
+        }
+        for (int i = np_old; i < np; ++i) {
+            rdata[i] = ParticleReal(i);
+            idata[i] = -i;
+        }
+        AMREX_ALWAYS_ASSERT(ptile.capacity() >= Long(np)*Long(sizeof(ParticleReal)));
+        if (ptile.capacity() != capacity) {
+            capacity = ptile.capacity();
+            ++nrealloc;
+        }
+    }
+    return nrealloc;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv, true, MPI_COMM_WORLD, [] ()
+    {
+        ParmParse pp("particles");
+        pp.add("tile_growth_factor", 2.0);
+    });
+    {
+        Box domain(IntVect(0), IntVect(15));
+        RealBox real_box(AMREX_D_DECL(Real(0),Real(0),Real(0)),
+                         AMREX_D_DECL(Real(1),Real(1),Real(1)));
+        Geometry geom(domain, real_box, CoordSys::cartesian, {AMREX_D_DECL(0,0,0)});
+        BoxArray ba(domain);
+        DistributionMapping dm(ba);
+        PC pc(geom, dm, ba);
+        AMREX_ALWAYS_ASSERT(PC::tile_growth_factor == Real(2));
+
+        // Without a growth factor, the tile is resized to the exact size.
+        {
+            PTile ptile;
+            ptile.define(pc.NumRuntimeRealComps(), pc.NumRuntimeIntComps());
+            AMREX_ALWAYS_ASSERT(grow(ptile) == 11);
+        }
+
+        // With particles.tile_growth_factor, the tiles of the container
+        // grow geometrically.
+        if (ParallelDescriptor::MyProc() == dm[0]) {
+            auto& ptile = pc.DefineAndReturnParticleTile(0, 0, 0);
+            AMREX_ALWAYS_ASSERT(grow(ptile) <= 2);
+        }
+
+        // A single tile can opt in.
+        {
+            PTile ptile;
+            ptile.define(pc.NumRuntimeRealComps(), pc.NumRuntimeIntComps());
+            ptile.setGrowthFactor(Real(2));
+            AMREX_ALWAYS_ASSERT(grow(ptile) <= 2);
+        }
+
+        // A vector with a growth factor of its own is extended in place by
+        // a CArena if the block after it is free.
+        {
+            CArena arena(1024*1024);
+            PODVector<int, PolymorphicArenaAllocator<int>> v;
+            v.setArena(&arena);
+            v.setGrowthFactor(Real(2));
+            v.resize(1000);
+            for (int i = 0; i < 1000; ++i) { v[i] = i; }
+            int const* p = v.data();
+            v.resize(1100);
+            AMREX_ALWAYS_ASSERT(v.data() == p);
+            AMREX_ALWAYS_ASSERT(v.capacity() >= 1100);
+            for (int i = 0; i < 1000; ++i) {
+                AMREX_ALWAYS_ASSERT(v[i] == i);
+            }
+        }
+
+        amrex::Print() << "SUCCESS\n";
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,165 @@
+#include <AMReX.H>
+#include <AMReX_AmrCore.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_Print.H>
+#include <AMReX_RecycleArena.H>
+#include <AMReX_TagBox.H>
+
+using namespace amrex;
+
+namespace {
+
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+Real f (int lev, int i, int j, int k)
+{
+    return Real(lev*1000000 + AMREX_D_TERM(i,+100*j,+10000*k));
+}
+
+// A refined sphere whose center depends on the time.
+class MyAmr
+    : public AmrCore
+{
+public:
+    using AmrCore::AmrCore;
+
+    Vector<MultiFab> phi = Vector<MultiFab>(2);
+    Long nhits = 0;
+    Long nmisses = 0;
+
+    void MakeNewLevelFromScratch (int lev, Real /*time*/, const BoxArray& ba,
+                                  const DistributionMapping& dm) override
+    {
+        phi[lev].define(ba, dm, 1, 0, MFInfo().SetArena(The_Recycle_Arena()));
+        fill(lev, phi[lev]);
+    }
+
+    void MakeNewLevelFromCoarse (int lev, Real time, const BoxArray& ba,
+                                 const DistributionMapping& dm) override
+    {
+        MakeNewLevelFromScratch(lev, time, ba, dm);
+    }
+
+    void RemakeLevel (int lev, Real /*time*/, const BoxArray& ba,
+                      const DistributionMapping& dm) override
+    {
+        MultiFab tmp(ba, dm, 1, 0, MFInfo().SetArena(The_Recycle_Arena()));
+        if (auto* ra = dynamic_cast<RecycleArena*>(The_Recycle_Arena())) {
+            auto [h, m] = ra->hits_and_misses();
+            nhits += h;
+            nmisses += m;
+        }
+        tmp.setVal(-1.0);
+        // The old data are still alive while the new data are filled.
+        tmp.ParallelCopy(phi[lev]);
+        fill(lev, tmp, true);
+        std::swap(tmp, phi[lev]);
+    }
+
+    void ClearLevel (int lev) override
+    {
+        phi[lev].clear();
+    }
+
+    void ErrorEst (int lev, TagBoxArray& tags, Real time, int /*ngrow*/) override
+    {
+        const Box domain = Geom(lev).Domain();
+        const Real r = Real(0.15) * Real(domain.length(0));
+        const Real cx = Real(domain.length(0)) * (Real(0.3) + Real(0.4)*time);
+        const Real cy = Real(domain.length(1)) * Real(0.5);
+#if (AMREX_SPACEDIM == 3)
+        const Real cz = Real(domain.length(2)) * Real(0.5);
+#endif
+        for (MFIter mfi(tags); mfi.isValid(); ++mfi) {
+            auto const& tag = tags.array(mfi);
+            amrex::ParallelFor(mfi.validbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k)
+            {
+                Real d2 = AMREX_D_TERM((Real(i)+Real(0.5)-cx)*(Real(i)+Real(0.5)-cx),
+                                       +(Real(j)+Real(0.5)-cy)*(Real(j)+Real(0.5)-cy),
+                                       +(Real(k)+Real(0.5)-cz)*(Real(k)+Real(0.5)-cz));
+                if (d2 < r*r) { tag(i,j,k) = TagBox::SET; }
+            });
+        }
+    }
+
+    static void fill (int lev, MultiFab& mf, bool only_unset = false)
+    {
+        auto const& ma = mf.arrays();
+        ParallelFor(mf, [=] AMREX_GPU_DEVICE (int b, int i, int j, int k)
+        {
+            if (!only_unset || ma[b](i,j,k) < Real(0.0)) {
+                ma[b](i,j,k) = f(lev,i,j,k);
+            }
+        });
+        Gpu::streamSynchronize();
+    }
+
+    [[nodiscard]] Long check () const
+    {
+        Long nerr = 0;
+        for (int lev = 0; lev <= finest_level; ++lev) {
+            auto const& ma = phi[lev].const_arrays();
+            nerr += ParReduce(TypeList<ReduceOpSum>{}, TypeList<Long>{}, phi[lev], IntVect(0),
+            [=] AMREX_GPU_DEVICE (int b, int i, int j, int k) -> GpuTuple<Long>
+            {
+                return { Long(ma[b](i,j,k) != f(lev,i,j,k)) };
+            });
+        }
+        ParallelDescriptor::ReduceLongSum(nerr);
+        return nerr;
+    }
+};
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        auto* ra = dynamic_cast<RecycleArena*>(The_Recycle_Arena());
+        AMREX_ALWAYS_ASSERT(ra != nullptr);
+
+        const int n_cell = 32;
+        Geometry geom(Box(IntVect(0), IntVect(n_cell-1)),
+                      RealBox({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)}),
+                      CoordSys::cartesian, {AMREX_D_DECL(0,0,0)});
+        AmrInfo info;
+        info.max_level = 1;
+        info.max_grid_size = {IntVect(16)};
+        info.blocking_factor = {IntVect(8)};
+
+        MyAmr amr(geom, info);
+        amr.InitFromScratch(0.0);
+        AMREX_ALWAYS_ASSERT(amr.finestLevel() == 1);
+        const BoxArray ba0 = amr.boxArray(1);
+
+        // Move the fine level.  The old blocks go to the pool.
+        amr.regrid(0, 1.0);
+        AMREX_ALWAYS_ASSERT(amr.boxArray(1) != ba0);
+        AMREX_ALWAYS_ASSERT(amr.check() == 0);
+        auto pooled = static_cast<Long>(ra->pooled_bytes());
+        ParallelDescriptor::ReduceLongSum(pooled);
+        AMREX_ALWAYS_ASSERT(pooled > 0);
+
+        // Move it back.  The new data reuse the blocks freed by the
+        // previous regrid.
+        amr.nhits = 0;
+        amr.nmisses = 0;
+        amr.regrid(0, 0.0);
+        AMREX_ALWAYS_ASSERT(amr.boxArray(1) == ba0);
+        AMREX_ALWAYS_ASSERT(amr.check() == 0);
+        Long nhits = amr.nhits;
+        ParallelDescriptor::ReduceLongSum(nhits);
+        AMREX_ALWAYS_ASSERT(nhits > 0);
+
+        // Nothing changes, and the blocks not reused are released.
+        amr.regrid(0, 0.0);
+        amr.regrid(0, 0.0);
+        AMREX_ALWAYS_ASSERT(amr.check() == 0);
+        pooled = static_cast<Long>(ra->pooled_bytes());
+        ParallelDescriptor::ReduceLongSum(pooled);
+        AMREX_ALWAYS_ASSERT(pooled == 0);
+
+        amrex::Print() << "SUCCESS\n";
+    }
+    amrex::Finalize();
+}
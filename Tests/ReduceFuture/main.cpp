@@ -0,0 +1,78 @@
+#include <AMReX.H>
+#include <AMReX_ParallelContext.H>
+#include <AMReX_ParallelReduce.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+namespace {
+
+// The nonblocking reductions give the same results as the blocking ones.
+// The values are integers, so that sums do not depend on the order.
+template <typename T>
+void test (MPI_Comm comm)
+{
+    const int myproc = ParallelDescriptor::MyProc(comm);
+    const int n = 5;
+    Vector<T> v(n);
+    for (int i = 0; i < n; ++i) {
+        v[i] = T((myproc*7 + i*3) % 11) - T(i);
+    }
+
+    auto fmax = ParallelAllReduce::MaxAsync(v[0], comm);
+    auto fmin = ParallelAllReduce::MinAsync(v[1], comm);
+    auto fsum = ParallelAllReduce::SumAsync(v[2], comm);
+    auto vmax = ParallelAllReduce::MaxAsync(v.data(), n, comm);
+    auto vmin = ParallelAllReduce::MinAsync(v.data(), n, comm);
+    auto vsum = ParallelAllReduce::SumAsync(v.data(), n, comm);
+
+    // The inputs are copied, so they may be changed right away.
+    const Vector<T> v0 = v;
+    std::fill(v.begin(), v.end(), T(-100));
+
+    // Moving a pending reduction keeps it valid.
+    Vector<ReduceFuture<T>> futures;
+    futures.push_back(std::move(fsum));
+    futures.push_back(ParallelAllReduce::SumAsync(v0.data(), n, comm));
+    while (!futures[1].test()) {}
+
+    Vector<T> r = v0;
+    ParallelAllReduce::Max(r[0], comm);
+    AMREX_ALWAYS_ASSERT(fmax.get() == r[0]);
+    ParallelAllReduce::Min(r[1], comm);
+    AMREX_ALWAYS_ASSERT(fmin.get() == r[1]);
+    ParallelAllReduce::Sum(r[2], comm);
+    AMREX_ALWAYS_ASSERT(futures[0].get() == r[2]);
+
+    r = v0;
+    ParallelAllReduce::Max(r.data(), n, comm);
+    AMREX_ALWAYS_ASSERT(vmax.getVector() == r);
+    r = v0;
+    ParallelAllReduce::Min(r.data(), n, comm);
+    AMREX_ALWAYS_ASSERT(vmin.getVector() == r);
+    r = v0;
+    ParallelAllReduce::Sum(r.data(), n, comm);
+    AMREX_ALWAYS_ASSERT(vsum.getVector() == r);
+    AMREX_ALWAYS_ASSERT(futures[1].getVector() == r);
+
+    // A future that is never waited on explicitly completes in its destructor.
+    {
+        auto f = ParallelAllReduce::SumAsync(v0[0], comm);
+    }
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        test<int>(ParallelDescriptor::Communicator());
+        test<Long>(ParallelDescriptor::Communicator());
+        test<Real>(ParallelDescriptor::Communicator());
+        test<Real>(ParallelContext::CommunicatorSub());
+
+        amrex::Print() << "SUCCESS\n";
+    }
+    amrex::Finalize();
+}
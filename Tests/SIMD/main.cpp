@@ -0,0 +1,142 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_Print.H>
+#include <AMReX_SIMD.H>
+
+using namespace amrex;
+
+namespace {
+
+constexpr Real gam = Real(1.4);
+constexpr Real pmin = Real(0.5);
+
+// The sound speed where the pressure is above pmin and the Mach number,
+// scaled by i, where the flow is supersonic.  Elsewhere the output keeps
+// its old value.
+void scalar_kernel (MultiFab& out, MultiFab const& q)
+{
+    for (MFIter mfi(out); mfi.isValid(); ++mfi) {
+        auto const& a = q.const_array(mfi);
+        auto const& o = out.array(mfi);
+        amrex::ParallelFor(mfi.validbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            Real rho = a(i,j,k,0);
+            Real p = a(i,j,k,1);
+            Real c = std::sqrt(gam*p/rho);
+            o(i,j,k,0) = (p > pmin) ? c : Real(0.);
+            Real u = (p > pmin) ? a(i,j,k,2) : Real(-1.);
+            if (u > c) {
+                o(i,j,k,1) = Real(i) * u / c;
+            }
+        });
+    }
+}
+
+template <int W>
+void simd_kernel (MultiFab& out, MultiFab const& q)
+{
+    for (MFIter mfi(out); mfi.isValid(); ++mfi) {
+        auto const& a = q.const_array(mfi);
+        auto const& o = out.array(mfi);
+        amrex::ParallelForSIMD<W>(mfi.validbox(),
+        [=] AMREX_GPU_DEVICE (auto const& ii, int j, int k)
+        {
+            using std::sqrt;
+            constexpr int B = std::decay_t<decltype(ii)>::width;
+            auto rho = simd::load(a, ii, j, k, 0);
+            auto p = simd::load(a, ii, j, k, 1);
+            AMREX_ALWAYS_ASSERT(!simd::any_of(rho <= Real(0.)));
+            auto c = sqrt(gam*p/rho);
+            auto m = p > pmin;
+            simd::store(simd::select(m, c, Real(0.)), o, ii, j, k, 0);
+            auto u = simd::load_if(m, simd::Vec<Real,B>(Real(-1.)), a, ii, j, k, 2);
+            auto s = u > c;
+            if (simd::none_of(s)) { return; }
+            simd::store_if(s, ii.template index<Real>() * u / c, o, ii, j, k, 1);
+        });
+    }
+}
+
+void fill (MultiFab& mf, int seed)
+{
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        auto const& a = mf.array(mfi);
+        amrex::ParallelFor(mfi.fabbox(), mf.nComp(),
+        [=] AMREX_GPU_DEVICE (int i, int j, int k, int n)
+        {
+            a(i,j,k,n) = Real(1 + (i*7 + j*13 + k*29 + n*3 + seed) % 17) * Real(0.125);
+        });
+    }
+}
+
+// Results must be identical, because the vector operations are the same
+// IEEE operations as the scalar ones.
+template <int W>
+void test (MultiFab const& q, MultiFab const& expected)
+{
+    MultiFab out(q.boxArray(), q.DistributionMap(), 2, 0);
+    fill(out, 3);
+    simd_kernel<W>(out, q);
+    MultiFab::Subtract(out, expected, 0, 0, 2, 0);
+    AMREX_ALWAYS_ASSERT(out.norm0(0) == Real(0.) && out.norm0(1) == Real(0.));
+}
+
+void test_1d ()
+{
+    const int n = 1003;
+    Gpu::DeviceVector<Real> x(n), y(n);
+    Real* px = x.data();
+    Real* py = y.data();
+    amrex::ParallelFor(n, [=] AMREX_GPU_DEVICE (int i)
+    {
+        px[i] = Real(i % 13) - Real(6.);
+        py[i] = Real(-1.);
+    });
+    Array4<Real const> const ax(px, Dim3{0,0,0}, Dim3{n,1,1}, 1);
+    Array4<Real> const ay(py, Dim3{0,0,0}, Dim3{n,1,1}, 1);
+    amrex::ParallelForSIMD(n, [=] AMREX_GPU_DEVICE (auto const& ii)
+    {
+        auto v = simd::load(ax, ii, 0, 0);
+        simd::store(simd::select(v > Real(0.), v, -v), ay, ii, 0, 0);
+    });
+    Long nerr = Reduce::Sum<Long>(n, [=] AMREX_GPU_DEVICE (int i) -> Long
+    {
+        return Long(py[i] != std::abs(px[i]));
+    });
+    AMREX_ALWAYS_ASSERT(nerr == 0);
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+#ifdef AMREX_USE_SIMD
+        static_assert(simd::batch_width<4> == 4);
+#else
+        static_assert(simd::batch_width<4> == 1);
+#endif
+
+        // Rows that do not fill whole batches
+        BoxArray ba(Box(IntVect(0), IntVect(AMREX_D_DECL(44,20,12))));
+        ba.maxSize(IntVect(AMREX_D_DECL(23,16,16)));
+        DistributionMapping dm(ba);
+
+        MultiFab q(ba, dm, 3, 0);
+        fill(q, 0);
+        MultiFab expected(ba, dm, 2, 0);
+        fill(expected, 3);
+        scalar_kernel(expected, q);
+
+        test<simd::native_width<Real>>(q, expected);
+        test<1>(q, expected);
+        test<4>(q, expected);
+        test<8>(q, expected);
+
+        test_1d();
+
+        amrex::Print() << "SUCCESS\n";
+    }
+    amrex::Finalize();
+}
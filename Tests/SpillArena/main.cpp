@@ -0,0 +1,96 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+
+#include <dirent.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+using namespace amrex;
+
+namespace {
+
+std::string spill_dir;
+
+// The number of entries in the spill directory
+int num_files ()
+{
+    int n = 0;
+    if (DIR* d = opendir(spill_dir.c_str())) {
+        while (dirent* e = readdir(d)) {
+            std::string name(e->d_name);
+            if (name != "." && name != "..") { ++n; }
+        }
+        closedir(d);
+    }
+    return n;
+}
+
+// The number of mappings of files in the spill directory
+int num_mappings ()
+{
+    int n = 0;
+    std::ifstream ifs("/proc/self/maps");
+    std::string line;
+    while (std::getline(ifs, line)) {
+        if (line.find(spill_dir + "/amrex_spill_") != std::string::npos) { ++n; }
+    }
+    return n;
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv, true, MPI_COMM_WORLD, [] ()
+    {
+        char tmpl[] = "/tmp/amrex_spill_test_XXXXXX";
+        AMREX_ALWAYS_ASSERT(mkdtemp(tmpl) != nullptr);
+        spill_dir = tmpl;
+        ParmParse pp("amrex");
+        pp.add("the_spill_arena_dir", spill_dir);
+    });
+    {
+        AMREX_ALWAYS_ASSERT(The_Spill_Arena() != The_Cpu_Arena());
+
+        BoxArray ba(Box(IntVect(0), IntVect(63)));
+        ba.maxSize(32);
+        DistributionMapping dm(ba);
+        {
+            MultiFab mf(ba, dm, 2, 1, MFInfo().SetArena(The_Spill_Arena()));
+            for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+                auto const& a = mf.array(mfi);
+                amrex::LoopOnCpu(mfi.fabbox(), mf.nComp(), [&] (int i, int j, int k, int n)
+                {
+                    a(i,j,k,n) = Real(i + 100*j + 10000*k + 1000000*n);
+                });
+            }
+
+            // The data are in memory mapped files, which have been unlinked.
+            if (mf.local_size() > 0) {
+                AMREX_ALWAYS_ASSERT(num_mappings() > 0);
+            }
+            AMREX_ALWAYS_ASSERT(num_files() == 0);
+
+            for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+                auto const& a = mf.const_array(mfi);
+                amrex::LoopOnCpu(mfi.fabbox(), mf.nComp(), [&] (int i, int j, int k, int n)
+                {
+                    AMREX_ALWAYS_ASSERT(a(i,j,k,n) == Real(i + 100*j + 10000*k + 1000000*n));
+                });
+            }
+        }
+
+        // The files are unmapped when the memory is returned to the system.
+        The_Spill_Arena()->freeUnused();
+        AMREX_ALWAYS_ASSERT(num_mappings() == 0);
+        AMREX_ALWAYS_ASSERT(num_files() == 0);
+        AMREX_ALWAYS_ASSERT(rmdir(spill_dir.c_str()) == 0);
+
+        amrex::Print() << "SUCCESS\n";
+    }
+    amrex::Finalize();
+}
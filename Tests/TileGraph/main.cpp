@@ -0,0 +1,142 @@
+#include <AMReX.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_Print.H>
+#include <AMReX_TileGraph.H>
+
+#include <algorithm>
+
+using namespace amrex;
+
+namespace {
+
+void init (MultiFab& mf, int seed)
+{
+    mf.setVal(-1.0);
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        auto const& a = mf.array(mfi);
+        amrex::LoopOnCpu(mfi.validbox(), mf.nComp(), [&] (int i, int j, int k, int n)
+        {
+            a(i,j,k,n) = Real((AMREX_D_TERM(7*i,+3*j,+5*k) + 2*n + seed) % 11);
+        });
+    }
+}
+
+Long ndiff (MultiFab const& a, MultiFab const& b, int ng)
+{
+    Long r = 0;
+    for (MFIter mfi(a); mfi.isValid(); ++mfi) {
+        auto const& x = a.const_array(mfi);
+        auto const& y = b.const_array(mfi);
+        amrex::LoopOnCpu(amrex::grow(mfi.validbox(),ng), a.nComp(), [&] (int i, int j, int k, int n)
+        {
+            r += Long(x(i,j,k,n) != y(i,j,k,n));
+        });
+    }
+    ParallelDescriptor::ReduceLongSum(r);
+    return r;
+}
+
+// lap = Laplacian(S), then S += lap
+void lap_tile (Box const& bx, Array4<Real const> const& s, Array4<Real> const& lap, int ncomp)
+{
+    amrex::LoopOnCpu(bx, ncomp, [&] (int i, int j, int k, int n)
+    {
+        lap(i,j,k,n) = AMREX_D_TERM(s(i-1,j,k,n) + s(i+1,j,k,n),
+                                   + s(i,j-1,k,n) + s(i,j+1,k,n),
+                                   + s(i,j,k-1,n) + s(i,j,k+1,n))
+            - Real(2*AMREX_SPACEDIM)*s(i,j,k,n);
+    });
+}
+
+void update_tile (Box const& bx, Array4<Real const> const& lap, Array4<Real> const& s, int ncomp)
+{
+    amrex::LoopOnCpu(bx, ncomp, [&] (int i, int j, int k, int n)
+    {
+        s(i,j,k,n) += lap(i,j,k,n);
+    });
+}
+
+// FillBoundary_progress reports every box at most once and gives the same
+// result as FillBoundary.
+void test_progress (Geometry const& geom, BoxArray const& ba, DistributionMapping const& dm)
+{
+    MultiFab a(ba, dm, 2, 2), b(ba, dm, 2, 2);
+    init(a, 0);
+    init(b, 0);
+    a.FillBoundary(geom.periodicity());
+
+    b.FillBoundary_nowait(geom.periodicity());
+    Vector<int> boxes;
+    while (!b.FillBoundary_progress(boxes)) {}
+    std::sort(boxes.begin(), boxes.end());
+    AMREX_ALWAYS_ASSERT(std::adjacent_find(boxes.begin(), boxes.end()) == boxes.end());
+    for (int i : boxes) {
+        AMREX_ALWAYS_ASSERT(dm[i] == ParallelDescriptor::MyProc());
+    }
+
+    AMREX_ALWAYS_ASSERT(ndiff(a, b, 2) == 0);
+}
+
+// A FillBoundary and two stages, executed twice, give the same result as
+// MFIter loops.
+void test_graph (Geometry const& geom, BoxArray const& ba, DistributionMapping const& dm,
+                 IntVect const& tilesize)
+{
+    const int ncomp = 2;
+    MultiFab s_ref(ba, dm, ncomp, 1), lap_ref(ba, dm, ncomp, 0);
+    MultiFab s(ba, dm, ncomp, 1), lap(ba, dm, ncomp, 0);
+    init(s_ref, 3);
+    init(s, 3);
+
+    for (int istep = 0; istep < 2; ++istep) {
+        s_ref.FillBoundary(geom.periodicity());
+        for (MFIter mfi(s_ref); mfi.isValid(); ++mfi) {
+            lap_tile(mfi.validbox(), s_ref.const_array(mfi), lap_ref.array(mfi), ncomp);
+        }
+        for (MFIter mfi(s_ref); mfi.isValid(); ++mfi) {
+            update_tile(mfi.validbox(), lap_ref.const_array(mfi), s_ref.array(mfi), ncomp);
+        }
+    }
+
+    TileGraph graph(s, tilesize);
+    graph.FillBoundary(s, geom.periodicity());
+    graph.addStage({TileGraph::Read(s,1), TileGraph::Write(lap)},
+                   [&] (TileGraph::Tile const& t)
+                   {
+                       lap_tile(t.tilebox(), s.const_array(t.index()), lap.array(t.index()), ncomp);
+                   });
+    graph.addStage({TileGraph::Read(lap), TileGraph::Write(s)},
+                   [&] (TileGraph::Tile const& t)
+                   {
+                       update_tile(t.tilebox(), lap.const_array(t.index()), s.array(t.index()), ncomp);
+                   });
+    AMREX_ALWAYS_ASSERT(graph.numStages() == 2);
+    graph.execute();
+    graph.execute();
+
+    AMREX_ALWAYS_ASSERT(ndiff(s_ref, s, 0) == 0);
+    AMREX_ALWAYS_ASSERT(ndiff(lap_ref, lap, 0) == 0);
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        Box domain(IntVect(0), IntVect(31));
+        Geometry geom(domain, RealBox({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)}),
+                      CoordSys::cartesian, {AMREX_D_DECL(1,1,1)});
+        BoxArray ba(domain);
+        ba.maxSize(16);
+        DistributionMapping dm(ba);
+
+        test_progress(geom, ba, dm);
+        test_graph(geom, ba, dm, IntVect(16));
+        test_graph(geom, ba, dm, IntVect(AMREX_D_DECL(1024,4,4)));
+
+        amrex::Print() << "SUCCESS\n";
+    }
+    amrex::Finalize();
+}
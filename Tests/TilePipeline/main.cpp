@@ -0,0 +1,157 @@
+#include <AMReX.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_Print.H>
+#include <AMReX_TilePipeline.H>
+
+using namespace amrex;
+
+namespace {
+
+// The three stages: fluxes on x-faces, an update, and a smoothing in y
+// that reads the source and both earlier stages.
+
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+void flux (int i, int j, int k, Array4<Real const> const& u, Array4<Real> const& f)
+{
+    f(i,j,k) = u(i,j,k) - u(i-1,j,k);
+}
+
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+void update (int i, int j, int k, Array4<Real const> const& u, Array4<Real const> const& f,
+             Array4<Real> const& v)
+{
+    v(i,j,k) = u(i,j,k) - Real(2.)*(f(i+1,j,k) - f(i,j,k));
+}
+
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+void smooth (int i, int j, int k, Array4<Real const> const& u, Array4<Real const> const& f,
+             Array4<Real const> const& v, Array4<Real> const& w)
+{
+#if (AMREX_SPACEDIM > 1)
+    w(i,j,k) = v(i,j-1,k) + Real(2.)*v(i,j,k) + v(i,j+1,k) + f(i,j,k) - u(i,j,k);
+#else
+    w(i,j,k) = Real(4.)*v(i,j,k) + f(i,j,k) - u(i,j,k);
+#endif
+}
+
+TilePipeline make_pipeline ()
+{
+    TilePipeline pipeline;
+    pipeline.addStage(1, IntVect(AMREX_D_DECL(1,0,0)),
+    [] (Box const& bx, TilePipeline::StageData const& d)
+    {
+        auto const& u = d.source();
+        auto const& f = d.output();
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            flux(i,j,k,u,f);
+        });
+    }, IndexType(IntVect(AMREX_D_DECL(1,0,0))));
+    pipeline.addStage(1, IntVect(AMREX_D_DECL(1,0,0)),
+    [] (Box const& bx, TilePipeline::StageData const& d)
+    {
+        auto const& u = d.source();
+        auto const& f = d.stage(0);
+        auto const& v = d.output();
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            update(i,j,k,u,f,v);
+        });
+    });
+    pipeline.addStage(1, IntVect(AMREX_D_DECL(0,1,0)),
+    [] (Box const& bx, TilePipeline::StageData const& d)
+    {
+        auto const& u = d.source();
+        auto const& f = d.stage(0);
+        auto const& v = d.stage(1);
+        auto const& w = d.output();
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            smooth(i,j,k,u,f,v,w);
+        });
+    });
+    return pipeline;
+}
+
+// The same stages, one MultiFab loop each
+void run_reference (MultiFab const& src, MultiFab& dst)
+{
+    const IntVect ng = src.nGrowVect();
+    MultiFab f(amrex::convert(src.boxArray(), IntVect(AMREX_D_DECL(1,0,0))),
+               src.DistributionMap(), 1, ng - IntVect(AMREX_D_DECL(1,0,0)));
+    MultiFab v(src.boxArray(), src.DistributionMap(), 1, ng - IntVect(AMREX_D_DECL(2,0,0)));
+    for (MFIter mfi(f); mfi.isValid(); ++mfi) {
+        auto const& u = src.const_array(mfi);
+        auto const& fa = f.array(mfi);
+        amrex::ParallelFor(mfi.fabbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            flux(i,j,k,u,fa);
+        });
+    }
+    for (MFIter mfi(v); mfi.isValid(); ++mfi) {
+        auto const& u = src.const_array(mfi);
+        auto const& fa = f.const_array(mfi);
+        auto const& va = v.array(mfi);
+        amrex::ParallelFor(mfi.fabbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            update(i,j,k,u,fa,va);
+        });
+    }
+    for (MFIter mfi(dst); mfi.isValid(); ++mfi) {
+        auto const& u = src.const_array(mfi);
+        auto const& fa = f.const_array(mfi);
+        auto const& va = v.const_array(mfi);
+        auto const& w = dst.array(mfi);
+        amrex::ParallelFor(mfi.validbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            smooth(i,j,k,u,fa,va,w);
+        });
+    }
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        Box domain(IntVect(0), IntVect(31));
+        Geometry geom(domain, RealBox({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)}),
+                      CoordSys::cartesian, {AMREX_D_DECL(1,1,1)});
+        BoxArray ba(domain);
+        ba.maxSize(16);
+        DistributionMapping dm(ba);
+
+        const TilePipeline pipeline = make_pipeline();
+        AMREX_ALWAYS_ASSERT(pipeline.numStages() == 3);
+        const IntVect ng = pipeline.nGrowSource();
+        AMREX_ALWAYS_ASSERT(ng.allLE(IntVect(2)));
+
+        MultiFab src(ba, dm, 1, IntVect(2));
+        for (MFIter mfi(src); mfi.isValid(); ++mfi) {
+            auto const& u = src.array(mfi);
+            amrex::ParallelFor(mfi.validbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k)
+            {
+                u(i,j,k) = Real((AMREX_D_TERM(7*i,+3*j*j,+5*k)) % 13);
+            });
+        }
+        src.FillBoundary(geom.periodicity());
+
+        MultiFab expected(ba, dm, 1, 0);
+        run_reference(src, expected);
+
+        for (auto const& tilesize : {IntVect(16), IntVect(AMREX_D_DECL(1024,4,4)),
+                                     IntVect(AMREX_D_DECL(8,2,1)), IntVect(1)})
+        {
+            MultiFab dst(ba, dm, 1, 0);
+            dst.setVal(-1.0);
+            pipeline.run(src, dst, tilesize);
+            MultiFab::Subtract(dst, expected, 0, 0, 1, 0);
+            AMREX_ALWAYS_ASSERT(dst.norm0() == Real(0.0));
+        }
+
+        amrex::Print() << "SUCCESS\n";
+    }
+    amrex::Finalize();
+}
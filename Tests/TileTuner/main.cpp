@@ -0,0 +1,161 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_TileTuner.H>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+using namespace amrex;
+
+namespace {
+
+const std::string label = "TileTuner test";
+
+// The key of a tuned loop, i.e., the largest extent of the local boxes.
+IntVect local_shape (MultiFab const& mf)
+{
+    IntVect shape(0);
+    for (int i : mf.IndexArray()) {
+        shape.max(mf.boxArray()[i].length());
+    }
+    return shape;
+}
+
+// Every cell is visited once whatever tile size the tuner picks.
+void run (MultiFab& mf)
+{
+    mf.setVal(0.0);
+    for (MFIter mfi(mf, MFItInfo().AutoTuneTiling(label)); mfi.isValid(); ++mfi) {
+        Box const& bx = mfi.tilebox();
+        auto const& a = mf.array(mfi);
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            a(i,j,k) += Real(1.0);
+        });
+    }
+    AMREX_ALWAYS_ASSERT(mf.min(0) == Real(1.0) && mf.max(0) == Real(1.0));
+}
+
+BoxArray make_boxarray ()
+{
+    // A small box first, so that it is not the shape of the key.
+    BoxList bl;
+    bl.push_back(Box(IntVect(0), IntVect(7)));
+    for (int i = 1; i <= 8; ++i) {
+        bl.push_back(Box(IntVect(AMREX_D_DECL(32*i,0,0)), IntVect(AMREX_D_DECL(32*i+31,31,31))));
+    }
+    return BoxArray(std::move(bl));
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+#ifdef AMREX_USE_MPI
+    MPI_Init(&argc, &argv);
+    int rank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#else
+    const int rank = 0;
+#endif
+
+    const std::string tuner_file = "tile_tuner_test.txt";
+    auto add_parameters = [&] ()
+    {
+        ParmParse pp("fabarray");
+        pp.add("tile_tuner_trials", 1);
+        pp.add("tile_tuner_file", tuner_file);
+    };
+
+    // Start untuned even if a previous run has left a file behind.
+    if (rank == 0) {
+        std::remove(tuner_file.c_str());
+    }
+#ifdef AMREX_USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+
+    IntVect ioproc_shape, ioproc_tilesize;
+
+    amrex::Initialize(argc, argv, true, MPI_COMM_WORLD, add_parameters);
+    {
+        AMREX_ALWAYS_ASSERT(TileTuner::Enabled());
+
+        const BoxArray ba = make_boxarray();
+        DistributionMapping dm(ba);
+        MultiFab mf(ba, dm, 1, 0);
+        const IntVect shape = local_shape(mf);
+
+        // One trial of every candidate
+        const auto candidates = TileTuner::Candidates(shape);
+        for (int i = 0; i < int(candidates.size()); ++i) {
+            run(mf);
+        }
+
+        // Locked in, so the tile size no longer changes.
+        const IntVect ts = TileTuner::TileSize(label, shape);
+        AMREX_ALWAYS_ASSERT(std::find(candidates.begin(), candidates.end(), ts)
+                            != candidates.end());
+        for (int i = 0; i < int(candidates.size()); ++i) {
+            run(mf);
+            AMREX_ALWAYS_ASSERT(TileTuner::TileSize(label, shape) == ts);
+        }
+
+        ioproc_shape = shape;
+        ioproc_tilesize = ts;
+        ParallelDescriptor::Bcast(ioproc_shape.begin(), AMREX_SPACEDIM,
+                                  ParallelDescriptor::IOProcessorNumber());
+        ParallelDescriptor::Bcast(ioproc_tilesize.begin(), AMREX_SPACEDIM,
+                                  ParallelDescriptor::IOProcessorNumber());
+    }
+    amrex::Finalize();
+
+    amrex::Initialize(argc, argv, true, MPI_COMM_WORLD, add_parameters);
+    {
+        // The I/O process has written its tile size for the shape of the
+        // large boxes.
+        if (ParallelDescriptor::IOProcessor()) {
+            std::ifstream ifs(tuner_file);
+            AMREX_ALWAYS_ASSERT(ifs.is_open());
+            std::string line;
+            bool found = false;
+            while (std::getline(ifs, line)) {
+                std::istringstream is(line);
+                std::string l;
+                IntVect shape, ts;
+                is >> std::quoted(l);
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) { is >> shape[d]; }
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) { is >> ts[d]; }
+                if (is && l == label) {
+                    AMREX_ALWAYS_ASSERT(shape == ioproc_shape && ts == ioproc_tilesize);
+                    found = true;
+                }
+            }
+            AMREX_ALWAYS_ASSERT(found);
+            AMREX_ALWAYS_ASSERT(ioproc_shape == IntVect(32));
+        }
+
+        // It is used right away by every process with the same key.
+        const BoxArray ba = make_boxarray();
+        DistributionMapping dm(ba);
+        MultiFab mf(ba, dm, 1, 0);
+        const IntVect shape = local_shape(mf);
+        if (shape == ioproc_shape) {
+            AMREX_ALWAYS_ASSERT(TileTuner::TileSize(label, shape) == ioproc_tilesize);
+            run(mf);
+            AMREX_ALWAYS_ASSERT(TileTuner::TileSize(label, shape) == ioproc_tilesize);
+        }
+
+        amrex::Print() << "SUCCESS\n";
+    }
+    amrex::Finalize();
+
+#ifdef AMREX_USE_MPI
+    MPI_Finalize();
+#endif
+}